@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file bit_packed_benchmark.cpp
+ * @brief Encode/decode throughput of `bytepack::bit_packed` for 32-bit and 64-bit values of a given delta width (bits
+ * of the largest difference from the block minimum), measured over the unpacked size of the values.
+ *
+ * Usage: bit_packed_benchmark [value_count] [width] [iterations]
+ */
+
+#include <bytepack/bytepack.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename T>
+void run(const char* name, const std::size_t value_count, const unsigned width, const int iterations)
+{
+  std::mt19937_64 rng(1);
+  const auto max_delta = width >= 8 * sizeof(T) ? ~T{ 0 } : static_cast<T>((T{ 1 } << width) - 1);
+  std::vector<T> values(value_count);
+  for (auto& value : values) {
+    value = static_cast<T>(1000 + (rng() & max_delta));
+  }
+
+  bytepack::binary_stream<std::endian::little> stream(value_count * sizeof(T) + value_count / 8 + 64);
+  std::vector<T> decoded;
+  bool ok = true;
+
+  const auto start = clock_type::now();
+  for (int i = 0; i < iterations; ++i) {
+    stream.reset();
+    ok = stream.write<bytepack::bit_packed>(values) && ok;
+  }
+  const auto encoded = clock_type::now();
+  for (int i = 0; i < iterations; ++i) {
+    bytepack::binary_stream<std::endian::little> reader(stream.data());
+    ok = reader.read<bytepack::bit_packed>(decoded) && ok;
+  }
+  const auto end = clock_type::now();
+
+  const double gigabytes = static_cast<double>(iterations) * static_cast<double>(value_count * sizeof(T)) / 1e9;
+  std::printf("%-8s width %2u: %zu -> %zu bytes, encode %6.2f GB/s, decode %6.2f GB/s%s\n", name, width,
+              value_count * sizeof(T), stream.data().size(),
+              gigabytes / std::chrono::duration<double>(encoded - start).count(),
+              gigabytes / std::chrono::duration<double>(end - encoded).count(),
+              ok && decoded == values ? "" : " (round trip FAILED)");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const std::size_t value_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 22;
+  const auto width = static_cast<unsigned>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 11);
+  const int iterations = argc > 3 ? std::atoi(argv[3]) : 20;
+
+  run<std::uint32_t>("uint32_t", value_count, std::min(width, 32U), iterations);
+  run<std::uint64_t>("uint64_t", value_count, width, iterations);
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file message_batch_benchmark.cpp
+ * @brief Throughput of sending small UDP messages over loopback: one `send` per message vs. `message_batch::send`
+ * (`sendmmsg`), while a receiver thread drains the socket with one `recv` per message vs. `receive_batch::receive`
+ * (`recvmmsg`).
+ *
+ * The send rate is the wall-clock time of the send loop, so it also includes the time the receiver thread takes from
+ * the sender when they share a core. The result depends heavily on the machine: on a single-core VM (g++ 12, -O2,
+ * 40-byte messages, batches of 64), both paths measured between 190,000 and 325,000 msg/s from run to run, with no
+ * consistent winner, since the per-datagram work of the loopback UDP stack outweighs the saved system calls. The
+ * user-space cost of batching (serializing into the batch and preparing the `mmsghdr` array) is about 10 ns per
+ * message. Measure on the target machine and network before choosing a batch size.
+ *
+ * Usage: message_batch_benchmark [message_count] [batch_size]
+ */
+
+#include <bytepack/message_batch.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+struct Quote
+{
+  std::uint32_t sequence{};
+  std::uint32_t instrument{};
+  double bid{};
+  double ask{};
+  std::uint64_t timestamp{};
+
+  template<std::endian E>
+  bool serialize(bytepack::binary_stream<E>& stream) const noexcept
+  {
+    return stream.write(sequence, instrument, bid, ask, timestamp);
+  }
+};
+
+struct udp_pair
+{
+  int sender{ ::socket(AF_INET, SOCK_DGRAM, 0) };
+  int receiver{ ::socket(AF_INET, SOCK_DGRAM, 0) };
+  sockaddr_in address{};
+
+  udp_pair()
+  {
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    int buffer_size = 32 * 1024 * 1024;
+    ::setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    timeval timeout{ 0, 200000 };
+    ::setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::bind(receiver, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::getsockname(receiver, reinterpret_cast<sockaddr*>(&address), &length);
+    ::connect(sender, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  }
+
+  ~udp_pair()
+  {
+    ::close(sender);
+    ::close(receiver);
+  }
+};
+
+using clock_type = std::chrono::steady_clock;
+
+struct result
+{
+  double send_seconds{};
+  std::size_t received{};
+};
+
+template<typename Send, typename Receive>
+result run(Send&& send, Receive&& receive)
+{
+  udp_pair sockets;
+  std::size_t received = 0;
+  std::thread receiver([&] { received = receive(sockets.receiver); });
+
+  const auto start = clock_type::now();
+  send(sockets.sender);
+  const auto end = clock_type::now();
+
+  receiver.join();
+  return result{ std::chrono::duration<double>(end - start).count(), received };
+}
+
+void report(const char* name, const result& value, const std::size_t message_count)
+{
+  std::printf("%-28s %10.0f msg/s sent, %zu/%zu received\n", name,
+              static_cast<double>(message_count) / value.send_seconds, value.received, message_count);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const std::size_t message_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const std::size_t batch_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+  const auto single = run(
+    [&](const int socket) {
+      bytepack::binary_stream stream(64);
+      for (std::uint32_t i = 0; i < message_count; ++i) {
+        stream.reset();
+        static_cast<void>(Quote{ i, 7, 1.25, 1.5, i }.serialize(stream));
+        static_cast<void>(::send(socket, stream.data().as<void>(), stream.data().size(), 0));
+      }
+    },
+    [&](const int socket) {
+      std::size_t received = 0;
+      std::uint8_t buffer[64];
+      while (::recv(socket, buffer, sizeof(buffer), 0) > 0) {
+        ++received;
+      }
+      return received;
+    });
+  report("send/recv per message", single, message_count);
+
+  const auto batched = run(
+    [&](const int socket) {
+      bytepack::message_batch batch(batch_size * 64);
+      for (std::uint32_t i = 0; i < message_count; ++i) {
+        static_cast<void>(batch.add([&](auto& stream) { return Quote{ i, 7, 1.25, 1.5, i }.serialize(stream); }));
+        if (batch.size() == batch_size) {
+          static_cast<void>(batch.send(socket));
+          batch.clear();
+        }
+      }
+      static_cast<void>(batch.send(socket));
+    },
+    [&](const int socket) {
+      std::size_t received = 0;
+      bytepack::receive_batch batch(batch_size, 64);
+      while (batch.receive(socket) > 0) {
+        received += batch.size();
+      }
+      return received;
+    });
+  report("sendmmsg/recvmmsg (batched)", batched, message_count);
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file aligned_buffer.hpp
+ * @brief Optional owning buffer with cache-line alignment and optional huge pages, for large (multi-megabyte)
+ * serialization buffers. It is used with binary_stream as a user-supplied buffer:
+ *
+ *   bytepack::aligned_buffer storage(64 * 1024 * 1024, bytepack::page_mode::transparent_huge_pages);
+ *   bytepack::binary_stream stream(storage.view());
+ *
+ * Huge pages reduce TLB misses when large buffers are written or read sequentially. They are supported on Linux:
+ * - `transparent_huge_pages`: the buffer is aligned to 2 MiB and `madvise(MADV_HUGEPAGE)` is applied.
+ * - `explicit_huge_pages`: the buffer is mapped with `MAP_HUGETLB` (requires reserved huge pages, see
+ *   `/proc/sys/vm/nr_hugepages`); falls back to transparent huge pages if the mapping fails.
+ * On other platforms, all modes allocate a 64-byte aligned buffer.
+ */
+
+#ifndef BYTEPACK_ALIGNED_BUFFER_HPP
+#define BYTEPACK_ALIGNED_BUFFER_HPP
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+enum class page_mode : std::uint8_t { default_pages, transparent_huge_pages, explicit_huge_pages };
+
+/**
+ * @class aligned_buffer
+ * @brief Owning, zero-initialized buffer aligned to at least 64 bytes (cache line size). Huge page buffers are aligned
+ * to 2 MiB.
+ *
+ * If the allocation fails, the buffer is empty (`operator bool()` returns false).
+ */
+class aligned_buffer final
+{
+public:
+  static constexpr std::size_t alignment = 64;
+  static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+  /**
+   * @param min_alignment Minimum alignment (power of two) if larger than 64 bytes, e.g. the block size for `O_DIRECT`.
+   */
+  explicit aligned_buffer(const std::size_t size, const page_mode mode = page_mode::default_pages,
+                          const std::size_t min_alignment = alignment) noexcept
+    : alignment_{ std::max(alignment, min_alignment) }
+  {
+    if (size == 0) {
+      return;
+    }
+#if defined(__linux__)
+    if (mode == page_mode::explicit_huge_pages && allocate_explicit_huge_pages(size)) {
+      return;
+    }
+    if (mode != page_mode::default_pages && allocate_transparent_huge_pages(size)) {
+      return;
+    }
+#else
+    static_cast<void>(mode);
+#endif
+    void* memory = ::operator new[](size, std::align_val_t{ alignment_ }, std::nothrow);
+    if (memory != nullptr) {
+      std::memset(memory, 0, size);
+      data_ = static_cast<std::uint8_t*>(memory);
+      size_ = size;
+      allocation_ = allocation::aligned_new;
+    }
+  }
+
+  ~aligned_buffer() noexcept { release(); }
+
+  aligned_buffer(const aligned_buffer&) = delete;
+  aligned_buffer& operator=(const aligned_buffer&) = delete;
+
+  aligned_buffer(aligned_buffer&& other) noexcept
+    : data_{ std::exchange(other.data_, nullptr) }, size_{ std::exchange(other.size_, 0) },
+      mapped_size_{ std::exchange(other.mapped_size_, 0) }, alignment_{ other.alignment_ },
+      allocation_{ std::exchange(other.allocation_, {}) }
+  {}
+
+  aligned_buffer& operator=(aligned_buffer&& other) noexcept
+  {
+    if (this != &other) {
+      release();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      mapped_size_ = std::exchange(other.mapped_size_, 0);
+      alignment_ = other.alignment_;
+      allocation_ = std::exchange(other.allocation_, {});
+    }
+    return *this;
+  }
+
+  [[nodiscard]] bytepack::buffer_view view() const noexcept { return bytepack::buffer_view(data_, size_); }
+
+  [[nodiscard]] std::uint8_t* data() const noexcept { return data_; }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  /**
+   * @brief Returns true if huge pages were requested for the buffer (explicitly mapped or advised to the kernel).
+   */
+  [[nodiscard]] bool huge_pages() const noexcept
+  {
+    return allocation_ == allocation::explicit_huge_pages || allocation_ == allocation::transparent_huge_pages;
+  }
+
+  explicit operator bool() const noexcept { return data_ != nullptr; }
+
+private:
+  enum class allocation : std::uint8_t { none, aligned_new, transparent_huge_pages, explicit_huge_pages };
+
+  static constexpr std::size_t round_to_huge_pages(const std::size_t size) noexcept
+  {
+    return (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+
+#if defined(__linux__)
+  bool allocate_explicit_huge_pages(const std::size_t size) noexcept
+  {
+#if defined(MAP_HUGETLB)
+    const std::size_t mapped_size = round_to_huge_pages(size);
+    void* memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory == MAP_FAILED) {
+      return false;
+    }
+    data_ = static_cast<std::uint8_t*>(memory); // anonymous mappings are zero-initialized
+    size_ = size;
+    mapped_size_ = mapped_size;
+    allocation_ = allocation::explicit_huge_pages;
+    return true;
+#else
+    static_cast<void>(size);
+    return false;
+#endif
+  }
+
+  bool allocate_transparent_huge_pages(const std::size_t size) noexcept
+  {
+    const std::size_t allocated_size = round_to_huge_pages(size);
+    void* memory = std::aligned_alloc(huge_page_size, allocated_size);
+    if (memory == nullptr) {
+      return false;
+    }
+#if defined(MADV_HUGEPAGE)
+    static_cast<void>(madvise(memory, allocated_size, MADV_HUGEPAGE)); // advisory, ignored if THP is disabled
+#endif
+    std::memset(memory, 0, size); // also pre-faults the pages
+    data_ = static_cast<std::uint8_t*>(memory);
+    size_ = size;
+    allocation_ = allocation::transparent_huge_pages;
+    return true;
+  }
+#endif
+
+  void release() noexcept
+  {
+    switch (allocation_) {
+      case allocation::aligned_new:
+        ::operator delete[](data_, std::align_val_t{ alignment_ });
+        break;
+      case allocation::transparent_huge_pages:
+        std::free(data_);
+        break;
+      case allocation::explicit_huge_pages:
+#if defined(__linux__)
+        munmap(data_, mapped_size_);
+#endif
+        break;
+      case allocation::none:
+        break;
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped_size_ = 0;
+    allocation_ = allocation::none;
+  }
+
+  std::uint8_t* data_{ nullptr };
+  std::size_t size_{ 0 };
+  std::size_t mapped_size_{ 0 };
+  std::size_t alignment_{ alignment };
+  allocation allocation_{ allocation::none };
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_ALIGNED_BUFFER_HPP
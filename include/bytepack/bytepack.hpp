@@ -31,6 +31,20 @@
 #include <concepts>
 #include <vector>
 #include <array>
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <span>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <optional>
+#include <variant>
+#include <utility>
+#include <source_location>
+#include <new>
+#include <cassert>
 
 namespace bytepack {
 
@@ -125,6 +139,78 @@ private:
   std::ptrdiff_t ssize_; // signed
 };
 
+/**
+ * @class const_buffer_view
+ * @brief A non-owning read-only counterpart of buffer_view for immutable data, e.g. `const` packets, string literals
+ * and read-only memory mappings. It is used with binary_reader. A buffer_view converts to a const_buffer_view.
+ */
+class const_buffer_view
+{
+public:
+  template<typename T, std::size_t N>
+  requires SerializableBuffer<T>
+  explicit constexpr const_buffer_view(const T (&array)[N]) noexcept
+    : data_{ static_cast<const void*>(array) }, size_{ N * sizeof(T) }, ssize_{ to_ssize(N * sizeof(T)) }
+  {}
+
+  template<typename T>
+  requires SerializableBuffer<T>
+  explicit constexpr const_buffer_view(const T* ptr, const std::size_t size) noexcept
+    : data_{ static_cast<const void*>(ptr) }, size_{ size * sizeof(T) }, ssize_{ to_ssize(size * sizeof(T)) }
+  {}
+
+  explicit const_buffer_view(const std::string& str) noexcept
+    : data_{ static_cast<const void*>(str.data()) }, size_{ str.size() }, ssize_{ to_ssize(str.size()) }
+  {}
+
+  explicit constexpr const_buffer_view(const std::string_view str) noexcept
+    : data_{ static_cast<const void*>(str.data()) }, size_{ str.size() }, ssize_{ to_ssize(str.size()) }
+  {}
+
+  template<typename T, std::size_t N>
+  requires SerializableBuffer<T>
+  explicit constexpr const_buffer_view(const std::array<T, N>& array) noexcept
+    : data_{ static_cast<const void*>(array.data()) }, size_{ N * sizeof(T) }, ssize_{ to_ssize(N * sizeof(T)) }
+  {}
+
+  explicit constexpr const_buffer_view(const void* ptr, const std::size_t size) noexcept
+    : data_{ ptr }, size_{ size }, ssize_{ to_ssize(size) }
+  {}
+
+  constexpr const_buffer_view(const buffer_view& buffer) noexcept
+    : data_{ buffer.as<const void>() }, size_{ buffer.size() }, ssize_{ buffer.ssize() }
+  {}
+
+  /**
+   * @brief Returns a typed read-only pointer to the buffer data.
+   */
+  template<typename T>
+  requires ValidBufferAccessType<T>
+  [[nodiscard]] constexpr const T* as() const noexcept
+  {
+    return static_cast<const T*>(data_);
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+
+  [[nodiscard]] constexpr std::ptrdiff_t ssize() const noexcept { return ssize_; }
+
+  [[nodiscard]] constexpr bool is_empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] explicit constexpr operator bool() const noexcept { return data_ != nullptr && size_ > 0; }
+
+private:
+  static constexpr std::ptrdiff_t to_ssize(const std::size_t size) noexcept
+  {
+    using R = std::common_type_t<std::ptrdiff_t, std::make_signed_t<decltype(size)>>;
+    return static_cast<R>(size);
+  }
+
+  const void* data_;
+  std::size_t size_;
+  std::ptrdiff_t ssize_; // signed
+};
+
 template<typename T>
 concept NetworkSerializableBasic =
   (std::is_fundamental_v<T> || std::is_enum_v<T>)&&std::is_pointer_v<T> == false && std::is_reference_v<T> == false;
@@ -148,528 +234,2796 @@ concept NetworkSerializableVector = std::is_same_v<T, std::vector<typename T::va
 template<typename T>
 concept NetworkSerializableString = std::same_as<T, std::string> || std::same_as<T, std::string_view>;
 
+// Types that can be held by std::optional and std::variant (C-style arrays cannot be held by value)
 template<typename T>
-concept NetworkSerializableType = NetworkSerializableBasic<T> || NetworkSerializableBasicArray<T>
-                                  || NetworkSerializableArray<T> || NetworkSerializableString<T>
-                                  || NetworkSerializableVector<T>;
+concept NetworkSerializableValue = NetworkSerializableBasic<T> || NetworkSerializableArray<T>
+                                   || NetworkSerializableString<T> || NetworkSerializableVector<T>;
+
+template<typename T>
+concept NetworkSerializableOptional =
+  std::is_same_v<T, std::optional<typename T::value_type>> && NetworkSerializableValue<typename T::value_type>;
+
+template<typename T>
+struct is_network_serializable_variant : std::false_type
+{};
+
+template<typename... Ts>
+struct is_network_serializable_variant<std::variant<Ts...>>
+  : std::bool_constant<((std::is_same_v<Ts, std::monostate> || NetworkSerializableValue<Ts>) && ...)>
+{};
+
+template<typename T>
+concept NetworkSerializableVariant = is_network_serializable_variant<T>::value;
+
+// Sequences of non-basic values, e.g. std::vector<std::string>, std::vector<std::vector<T>>, std::list<std::string>
+// (vectors of basic types are serialized with a single copy by NetworkSerializableVector overloads)
+template<typename T>
+concept NetworkSerializableSequence =
+  (std::is_same_v<T, std::deque<typename T::value_type, typename T::allocator_type>>
+   || std::is_same_v<T, std::list<typename T::value_type, typename T::allocator_type>>
+   || (std::is_same_v<T, std::vector<typename T::value_type, typename T::allocator_type>>
+       && NetworkSerializableBasic<typename T::value_type> == false))
+  && NetworkSerializableValue<typename T::value_type>;
+
+template<typename T>
+concept NetworkSerializableMap =
+  (std::is_same_v<T, std::map<typename T::key_type, typename T::mapped_type, typename T::key_compare,
+                              typename T::allocator_type>>
+   || std::is_same_v<T, std::unordered_map<typename T::key_type, typename T::mapped_type, typename T::hasher,
+                                           typename T::key_equal, typename T::allocator_type>>)
+  && NetworkSerializableValue<typename T::key_type> && NetworkSerializableValue<typename T::mapped_type>;
+
+// Sorted vector of key-value pairs (std::flat_map-style). It has the same serialized format as maps.
+template<typename T>
+concept NetworkSerializableFlatMap =
+  std::is_same_v<T, std::vector<typename T::value_type, typename T::allocator_type>>
+  && std::is_same_v<typename T::value_type,
+                    std::pair<typename T::value_type::first_type, typename T::value_type::second_type>>
+  && NetworkSerializableValue<typename T::value_type::first_type>
+  && NetworkSerializableValue<typename T::value_type::second_type>;
+
+template<typename T>
+concept NetworkSerializableContainer =
+  NetworkSerializableSequence<T> || NetworkSerializableMap<T> || NetworkSerializableFlatMap<T>;
 
 template<typename T>
 concept IntegralType = std::is_integral_v<T>;
 
-enum class StringMode {
-  Default, // String length is serialized as metadata before the string data (default)
-  NullTerm // Null terminator is appended to the string data instead of prepending string length metadata
-};
+// Types whose serialized size is known at compile time (no size prefix, no terminator)
+template<typename T>
+concept NetworkSerializableFixedSize =
+  NetworkSerializableBasic<T> || NetworkSerializableBasicArray<T> || NetworkSerializableArray<T>;
+
+template<NetworkSerializableFixedSize T>
+inline constexpr std::size_t wire_size_v = sizeof(T);
+
+template<NetworkSerializableArray T>
+inline constexpr std::size_t wire_size_v<T> = std::tuple_size_v<T> * sizeof(typename T::value_type);
 
 /**
- * @class binary_stream
- * @brief A class for serializing and deserializing binary data with support for different endianness.
- * It supports handling both internally allocated buffers and user-supplied buffers.
+ * @struct field_layout
+ * @brief Compile-time description of a fixed-size message as an ordered list of field types.
  *
- * @tparam BufferEndian The endianness to use for serialization and deserialization.
- *                      Defaults to big-endian (network byte order).
+ * Byte offsets of the fields are computed at compile time, so a single field can be read or written
+ * with `binary_stream::read_field<Layout, Index>()` / `write_field<Layout, Index>()` without touching
+ * the other fields. For instance, offset of the 3rd field (index 2) of
+ * `field_layout<std::int32_t, double, float>` is 12.
+ *
+ * @tparam Fields Field types in the order they appear in the serialized data.
  */
-template<std::endian BufferEndian = std::endian::big>
-class binary_stream final
+template<NetworkSerializableFixedSize... Fields>
+struct field_layout
 {
-public:
-  explicit binary_stream(const std::size_t buffer_size) noexcept
-    : buffer_{ new std::uint8_t[buffer_size]{}, buffer_size }, owns_buffer_{ true }, write_index_{ 0 }, read_index_{ 0 }
-  {}
+  static constexpr std::size_t field_count = sizeof...(Fields);
+
+  // Total serialized size of all fields in bytes
+  static constexpr std::size_t size = (std::size_t{ 0 } + ... + wire_size_v<Fields>);
+
+  template<std::size_t Index>
+  requires(Index < field_count)
+  using field_type = std::tuple_element_t<Index, std::tuple<Fields...>>;
+
+  template<std::size_t Index>
+  requires(Index < field_count)
+  static constexpr std::size_t offset = [] {
+    constexpr std::array<std::size_t, field_count> sizes{ wire_size_v<Fields>... };
+    std::size_t byte_offset = 0;
+    for (std::size_t i = 0; i < Index; ++i) {
+      byte_offset += sizes[i];
+    }
+    return byte_offset;
+  }();
+};
 
-  explicit constexpr binary_stream(const bytepack::buffer_view& buffer) noexcept
-    : buffer_{ buffer }, owns_buffer_{ false }, write_index_{ 0 }, read_index_{ 0 }
-  {}
+template<typename T>
+struct is_field_layout : std::false_type
+{};
 
-  ~binary_stream() noexcept
-  {
-    if (owns_buffer_) {
-      delete[] buffer_.as<std::uint8_t>();
-    }
-  }
+template<typename... Fields>
+struct is_field_layout<field_layout<Fields...>> : std::true_type
+{};
 
-  binary_stream(const binary_stream&) = delete;
-  binary_stream& operator=(const binary_stream&) = delete;
-  binary_stream(binary_stream&&) = delete;
-  binary_stream& operator=(binary_stream&&) = delete;
+template<typename T>
+concept FieldLayout = is_field_layout<T>::value;
 
-  constexpr void reset() noexcept
-  {
-    write_index_ = 0;
-    read_index_ = 0;
-  }
+/**
+ * @brief Structs whose memory layout is their serialized format. The struct opts in by declaring its members as a
+ * field_layout, in declaration order:
+ *
+ *   struct SensorSample
+ *   {
+ *     std::uint32_t id;
+ *     std::int16_t value;
+ *     std::uint8_t flags[2];
+ *
+ *     using wire_layout = bytepack::field_layout<std::uint32_t, std::int16_t, std::uint8_t[2]>;
+ *   };
+ *
+ * Such structs and vectors of them are written and read with a single memcpy. `write`/`read` check at compile time
+ * that the struct qualifies: trivially copyable, standard layout, no padding (`sizeof` equals the size of the layout)
+ * and either the stream endianness is native or all fields are single-byte.
+ */
+template<typename T>
+concept WireStruct =
+  std::is_class_v<T> && requires { typename T::wire_layout; } && FieldLayout<typename T::wire_layout>;
 
-  [[nodiscard]] bytepack::buffer_view data() const noexcept
-  {
-    return bytepack::buffer_view(buffer_.as<std::uint8_t>(), write_index_);
-  }
+template<typename T>
+concept WireStructVector = std::is_same_v<T, std::vector<typename T::value_type, typename T::allocator_type>>
+                           && WireStruct<typename T::value_type>;
 
-  template<NetworkSerializableBasic T>
-  bool write(const T& value) noexcept
-  {
-    if (buffer_.size() < (write_index_ + sizeof(T))) {
-      return false;
-    }
+template<typename T>
+concept NetworkSerializableType = NetworkSerializableBasic<T> || NetworkSerializableBasicArray<T>
+                                  || NetworkSerializableArray<T> || NetworkSerializableString<T>
+                                  || NetworkSerializableVector<T> || NetworkSerializableOptional<T>
+                                  || NetworkSerializableVariant<T> || NetworkSerializableContainer<T>
+                                  || WireStruct<T> || WireStructVector<T>;
 
-    std::memcpy(buffer_.as<std::uint8_t>() + write_index_, &value, sizeof(T));
+namespace detail {
 
-    if constexpr (BufferEndian != std::endian::native && sizeof(T) > 1) {
-      // TODO: htonl/htons/ntohl/ntohs performs better for endianness conversion. However, it
-      // requires platform-specific headers. It is possible to implement hton/ntoh like functions
-      // in the library in a platform-independent way using bit shifts.
-      // Benchmark link: https://quick-bench.com/q/va-kzUk1J1BfvSgR05Z1YPnrJhg
-      std::ranges::reverse(buffer_.as<std::uint8_t>() + write_index_,
-                           buffer_.as<std::uint8_t>() + write_index_ + sizeof(T));
-    }
+template<typename T>
+struct wire_element
+{
+  using type = std::remove_extent_t<T>;
+};
 
-    write_index_ += sizeof(T);
+template<typename T, std::size_t N>
+struct wire_element<std::array<T, N>>
+{
+  using type = T;
+};
 
-    return true;
-  }
+// Size of the largest scalar (array element) in the layout
+template<typename... Fields>
+constexpr std::size_t max_element_size(field_layout<Fields...>) noexcept
+{
+  return std::max({ std::size_t{ 1 }, sizeof(typename wire_element<Fields>::type)... });
+}
 
-  template<NetworkSerializableBasicArray T>
-  bool write(const T& value) noexcept
-  {
-    using ElementType = std::remove_extent_t<T>;
-    constexpr std::size_t elementSize = sizeof(ElementType);
-    constexpr std::size_t numElements = sizeof(T) / elementSize;
+template<typename... Fields>
+constexpr bool has_floating_point_field(field_layout<Fields...>) noexcept
+{
+  return (std::is_floating_point_v<typename wire_element<Fields>::type> || ...);
+}
 
-    // Check if there is enough space in the buffer for the entire array
-    if (buffer_.size() < (write_index_ + sizeof(T))) {
+// True if the fields, placed in order at their natural alignment, leave no holes and no tail padding
+template<typename... Fields>
+constexpr bool is_hole_free(field_layout<Fields...>) noexcept
+{
+  constexpr std::array<std::size_t, sizeof...(Fields)> sizes{ wire_size_v<Fields>... };
+  constexpr std::array<std::size_t, sizeof...(Fields)> alignments{ alignof(Fields)... };
+  std::size_t offset = 0;
+  std::size_t max_alignment = 1;
+  for (std::size_t i = 0; i < sizes.size(); ++i) {
+    if (offset % alignments[i] != 0) {
       return false;
     }
+    offset += sizes[i];
+    max_alignment = std::max(max_alignment, alignments[i]);
+  }
+  return offset % max_alignment == 0;
+}
 
-    if constexpr (BufferEndian == std::endian::native || elementSize == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, value, sizeof(T));
-      write_index_ += sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < numElements; ++i) {
-        std::memcpy(buffer_.as<std::uint8_t>() + write_index_, &value[i], elementSize);
-        std::ranges::reverse(buffer_.as<std::uint8_t>() + write_index_,
-                             buffer_.as<std::uint8_t>() + write_index_ + elementSize);
-        write_index_ += elementSize;
-      }
-    }
+template<WireStruct T, std::endian BufferEndian>
+consteval bool check_wire_struct() noexcept
+{
+  using Layout = typename T::wire_layout;
+  static_assert(std::is_trivially_copyable_v<T>, "wire_layout struct must be trivially copyable");
+  static_assert(std::is_standard_layout_v<T>, "wire_layout struct must be standard layout");
+  static_assert(sizeof(T) == Layout::size && is_hole_free(Layout{}),
+                "wire_layout struct has padding or its wire_layout does not match its members");
+  // Padding bytes are not a unique object representation. Floating-point types are excluded by the trait itself
+  // (e.g. +0.0 and -0.0), so structs with floating-point fields rely on the layout checks above.
+  static_assert(has_floating_point_field(Layout{}) || std::has_unique_object_representations_v<T>,
+                "wire_layout struct has padding bytes");
+  static_assert(BufferEndian == std::endian::native || max_element_size(Layout{}) == 1,
+                "wire_layout struct with multi-byte fields requires a stream of native endianness");
+  return true;
+}
+
+} // namespace detail
 
-    return true;
-  }
+/**
+ * @struct float16
+ * @brief IEEE 754 half-precision (binary16) encoding for floating-point fields: 1 sign bit, 5 exponent bits and 10
+ * fraction bits (about 3 significant decimal digits, max 65504). Conversion rounds to nearest even; values out of range
+ * become infinity. Double values are converted to float first.
+ *
+ * Usage: `stream.write<bytepack::float16>(value);` and `stream.read<bytepack::float16>(value);`
+ */
+struct float16
+{
+  using wire_type = std::uint16_t;
 
-  template<typename T, std::size_t N>
-  requires NetworkSerializableBasic<T>
-  bool write(const std::array<T, N>& array) noexcept
+  template<std::floating_point T>
+  static constexpr wire_type encode(const T value) noexcept
   {
-    if (buffer_.size() < (write_index_ + N * sizeof(T))) {
-      // Array elements cannot fit in the remaining buffer space
-      return false;
-    }
+    const auto bits = std::bit_cast<std::uint32_t>(static_cast<float>(value));
+    const std::uint32_t sign = (bits >> 16) & 0x8000U;
+    const std::uint32_t abs = bits & 0x7FFFFFFFU;
 
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, array.data(), N * sizeof(T));
-      write_index_ += N * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < N; ++i) {
-        std::memcpy(buffer_.as<std::uint8_t>() + write_index_, &array[i], sizeof(T));
-        std::ranges::reverse(buffer_.as<std::uint8_t>() + write_index_,
-                             buffer_.as<std::uint8_t>() + write_index_ + sizeof(T));
-        write_index_ += sizeof(T);
+    if (abs >= 0x7F800000U) {
+      // Infinity or NaN (NaN is kept quiet)
+      return static_cast<wire_type>(sign | 0x7C00U | (abs > 0x7F800000U ? 0x0200U | ((abs >> 13) & 0x03FFU) : 0U));
+    }
+    if (abs >= 0x477FF000U) {
+      return static_cast<wire_type>(sign | 0x7C00U); // rounds to infinity (>= 65520)
+    }
+    if (abs < 0x38800000U) {
+      // Subnormal half (< 2^-14) or zero
+      if (abs <= 0x33000000U) {
+        return static_cast<wire_type>(sign); // <= 2^-25 rounds to zero
       }
+      const std::uint32_t shift = 126U - (abs >> 23);
+      const std::uint32_t mantissa = (abs & 0x007FFFFFU) | 0x00800000U;
+      std::uint32_t half = mantissa >> shift;
+      const std::uint32_t remainder = mantissa & ((1U << shift) - 1U);
+      const std::uint32_t halfway = 1U << (shift - 1U);
+      if (remainder > halfway || (remainder == halfway && (half & 1U) != 0)) {
+        ++half;
+      }
+      return static_cast<wire_type>(sign | half);
     }
-    return true;
+
+    // Normal: rebias the exponent (127 -> 15) and round the fraction to nearest even
+    std::uint32_t half = (abs - 0x38000000U) >> 13;
+    const std::uint32_t remainder = abs & 0x1FFFU;
+    if (remainder > 0x1000U || (remainder == 0x1000U && (half & 1U) != 0)) {
+      ++half;
+    }
+    return static_cast<wire_type>(sign | half);
   }
 
-  template<IntegralType SizeType = std::uint32_t, typename T>
-  requires NetworkSerializableBasic<T>
-  bool write(const std::vector<T>& vector) noexcept
+  template<std::floating_point T>
+  static constexpr T decode(const wire_type value) noexcept
   {
-    // When serializing dynamic size containers (if fixed size is not given), always include the container's size as
-    // metadata before the container data. This is crucial even for empty containers, as it allows the deserializer to
-    // accurately determine if the container is empty or contains data.
-    if (buffer_.size() < (write_index_ + sizeof(SizeType) + vector.size() * sizeof(T))) {
-      // Vector size field and its elements cannot fit in the remaining buffer space
-      return false;
+    const std::uint32_t sign = (static_cast<std::uint32_t>(value) & 0x8000U) << 16;
+    const std::uint32_t exponent = (value >> 10) & 0x1FU;
+    const std::uint32_t mantissa = value & 0x03FFU;
+
+    if (exponent == 0) {
+      // Zero or subnormal: mantissa * 2^-24
+      const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+      return static_cast<T>(sign != 0 ? -magnitude : magnitude);
     }
 
-    const auto size_custom = static_cast<SizeType>(vector.size());
-    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != vector.size()) {
-      // Overflow or incorrect size type
-      return false;
-    }
+    const std::uint32_t bits = exponent == 0x1FU ? (sign | 0x7F800000U | (mantissa << 13))
+                                                 : (sign | ((exponent + 112U) << 23) | (mantissa << 13));
+    return static_cast<T>(std::bit_cast<float>(bits));
+  }
+};
 
-    // Write vector size field first (before the vector data)
-    if (write(size_custom) == false) {
-      return false;
-    }
+/**
+ * @struct bfloat16
+ * @brief Brain floating-point encoding: upper 16 bits of an IEEE 754 float (1 sign bit, 8 exponent bits, 7 fraction
+ * bits). It keeps the range of float with about 2 significant decimal digits. Conversion rounds to nearest even.
+ */
+struct bfloat16
+{
+  using wire_type = std::uint16_t;
 
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, vector.data(), vector.size() * sizeof(T));
-      write_index_ += vector.size() * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < vector.size(); ++i) {
-        std::memcpy(buffer_.as<std::uint8_t>() + write_index_, &vector[i], sizeof(T));
-        std::ranges::reverse(buffer_.as<std::uint8_t>() + write_index_,
-                             buffer_.as<std::uint8_t>() + write_index_ + sizeof(T));
-        write_index_ += sizeof(T);
-      }
+  template<std::floating_point T>
+  static constexpr wire_type encode(const T value) noexcept
+  {
+    const auto bits = std::bit_cast<std::uint32_t>(static_cast<float>(value));
+    if ((bits & 0x7FFFFFFFU) > 0x7F800000U) {
+      return static_cast<wire_type>((bits >> 16) | 0x0040U); // quiet NaN
     }
-    return true;
+    return static_cast<wire_type>((bits + 0x7FFFU + ((bits >> 16) & 1U)) >> 16);
   }
 
-  template<std::size_t N, typename T>
-  requires NetworkSerializableBasic<T>
-  bool write(const std::vector<T>& vector) noexcept
+  template<std::floating_point T>
+  static constexpr T decode(const wire_type value) noexcept
   {
-    if (vector.size() < N || buffer_.size() < (write_index_ + N * sizeof(T))) {
-      return false;
-    }
-
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, vector.data(), N * sizeof(T));
-      write_index_ += N * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < N; ++i) {
-        std::memcpy(buffer_.as<std::uint8_t>() + write_index_, &vector[i], sizeof(T));
-        std::ranges::reverse(buffer_.as<std::uint8_t>() + write_index_,
-                             buffer_.as<std::uint8_t>() + write_index_ + sizeof(T));
-        write_index_ += sizeof(T);
-      }
-    }
-    return true;
+    return static_cast<T>(std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16));
   }
+};
 
-  template<IntegralType SizeType = std::uint32_t, NetworkSerializableString StringType>
-  bool write(const StringType& value) noexcept
+/**
+ * @struct fixed_point
+ * @brief Scaled fixed-point encoding: the value is multiplied by `Scale`, rounded to nearest and saturated to the range
+ * of `WireType`. For instance, `fixed_point<std::int16_t, 100>` stores -327.68 to 327.67 with 0.01 resolution. NaN is
+ * encoded as zero.
+ */
+template<IntegralType WireType, std::intmax_t Scale>
+requires(Scale > 0)
+struct fixed_point
+{
+  using wire_type = WireType;
+
+  template<std::floating_point T>
+  static wire_type encode(const T value) noexcept
   {
-    const auto str_length = static_cast<SizeType>(value.length());
-    if ((std::is_signed_v<SizeType> && str_length < 0) || static_cast<std::size_t>(str_length) != value.length()) {
-      // Overflow or incorrect size type
-      return false;
+    const T scaled = std::round(value * static_cast<T>(Scale));
+    if (std::isnan(scaled)) {
+      return wire_type{ 0 };
     }
-
-    if (buffer_.size() < (write_index_ + sizeof(SizeType) + value.length())) {
-      // String data and its length field cannot fit in the remaining buffer space
-      return false;
+    if (scaled <= static_cast<T>(std::numeric_limits<wire_type>::min())) {
+      return std::numeric_limits<wire_type>::min();
     }
-
-    // Write string length field first (before the string data)
-    if (write(str_length) == false) {
-      return false;
+    if (scaled >= static_cast<T>(std::numeric_limits<wire_type>::max())) {
+      return std::numeric_limits<wire_type>::max();
     }
-
-    std::memcpy(buffer_.as<std::uint8_t>() + write_index_, value.data(), value.length());
-    write_index_ += value.length();
-
-    return true;
+    return static_cast<wire_type>(scaled);
   }
 
-  template<std::size_t N, NetworkSerializableString StringType>
-  bool write(const StringType& value) noexcept
+  template<std::floating_point T>
+  static constexpr T decode(const wire_type value) noexcept
   {
-    if (buffer_.size() < (write_index_ + N)) {
-      // Not enough space in the buffer to write the string
-      return false;
-    }
-
-    if (value.length() >= N) {
-      // If the string is longer or equal to the specified length, write only the required part
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, value.data(), N);
-    } else {
-      // If the string is shorter, write the string and pad the rest with null characters
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, value.data(), value.length());
-      std::memset(buffer_.as<std::uint8_t>() + write_index_ + value.length(), '\0', N - value.length());
-    }
-
-    write_index_ += N;
-    return true;
+    return static_cast<T>(value) / static_cast<T>(Scale);
   }
+};
 
-  template<bytepack::StringMode Mode, NetworkSerializableString StringType>
-  bool write(const StringType& value) noexcept
-  {
-    if constexpr (Mode == bytepack::StringMode::NullTerm) {
-      const std::size_t str_length = value.length() + 1; // +1 for null terminator
+// Encoding of floating-point values on the wire, such as float16, bfloat16 and fixed_point. Custom encodings can be
+// added by providing a `wire_type` and static `encode`/`decode` functions.
+template<typename E>
+concept FloatEncoding = requires(float value, typename E::wire_type wire) {
+  { E::encode(value) } -> std::same_as<typename E::wire_type>;
+  { E::template decode<float>(wire) } -> std::same_as<float>;
+} && NetworkSerializableBasic<typename E::wire_type>;
 
-      if (buffer_.size() < (write_index_ + str_length)) {
-        return false;
-      }
+enum class StringMode {
+  Default, // String length is serialized as metadata before the string data (default)
+  NullTerm // Null terminator is appended to the string data instead of prepending string length metadata
+};
 
-      std::memcpy(buffer_.as<std::uint8_t>() + write_index_, value.data(), str_length - 1);
-      buffer_.as<char>()[write_index_ + str_length - 1] = '\0'; // null terminator
-      write_index_ += str_length;
-    } else {
-      // Fallback to existing method for serialization without null termination
-      return write(value); // Call the existing method for StringType
-    }
+enum class ErrorMode {
+  Default, // Each failed read/write returns false, later calls are still performed
+  Sticky   // After the first failure, all later sequential reads/writes fail without touching the buffer or values
+};
 
-    return true;
-  }
+/**
+ * Error codes reported by binary_stream::error().
+ */
+enum class error_code : std::uint8_t {
+  success = 0,
+  buffer_overflow,   // Not enough space in the buffer to write, or not enough data to read
+  size_overflow,     // Size of the string/container cannot be represented by the given size type
+  invalid_size,      // Negative or inconsistent size field, or fewer elements than the given fixed size
+  invalid_value,     // Invalid presence byte, variant tag, duplicate map key, etc.
+  missing_terminator // Null terminator of the string is not found in the buffer
+};
+
+/**
+ * @struct stream_error
+ * @brief The first error of a binary_stream and the byte offset in the buffer where the failing field starts.
+ *
+ * Converts to `true` if there is an error: `if (stream.error()) { ... }`
+ */
+struct stream_error
+{
+  error_code code{ error_code::success };
+  std::size_t offset{ 0 };
+
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return code != error_code::success; }
+};
+
+namespace detail {
+
+template<std::size_t Size>
+struct unsigned_of_size
+{};
+
+template<>
+struct unsigned_of_size<2>
+{
+  using type = std::uint16_t;
+};
+
+template<>
+struct unsigned_of_size<4>
+{
+  using type = std::uint32_t;
+};
+
+template<>
+struct unsigned_of_size<8>
+{
+  using type = std::uint64_t;
+};
+
+// Byte swap with shifts, which compilers recognize as a single bswap/rev instruction (and vectorize in loops)
+constexpr std::uint16_t byteswap(const std::uint16_t value) noexcept
+{
+  return static_cast<std::uint16_t>((value << 8) | (value >> 8));
+}
+
+constexpr std::uint32_t byteswap(const std::uint32_t value) noexcept
+{
+  return ((value & 0x000000FFU) << 24) | ((value & 0x0000FF00U) << 8) | ((value & 0x00FF0000U) >> 8)
+         | ((value & 0xFF000000U) >> 24);
+}
+
+constexpr std::uint64_t byteswap(const std::uint64_t value) noexcept
+{
+  return (static_cast<std::uint64_t>(byteswap(static_cast<std::uint32_t>(value))) << 32)
+         | byteswap(static_cast<std::uint32_t>(value >> 32));
+}
+
+// Returns the bytes of a value in the buffer byte order. It is constexpr, so the packets of `make_packet` are
+// converted the same way as the stream.
+template<std::endian BufferEndian, NetworkSerializableBasic T>
+constexpr std::array<std::uint8_t, sizeof(T)> to_buffer_bytes(const T& value) noexcept
+{
+  using bytes_type = std::array<std::uint8_t, sizeof(T)>;
+  if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
+    return std::bit_cast<bytes_type>(value);
+  } else if constexpr (requires { typename unsigned_of_size<sizeof(T)>::type; }) {
+    // Byte swap through an unsigned integer of the same size. It has no per-byte branches, so compilers vectorize
+    // the loops of bulk copies.
+    using U = typename unsigned_of_size<sizeof(T)>::type;
+    return std::bit_cast<bytes_type>(byteswap(std::bit_cast<U>(value)));
+  } else {
+    auto bytes = std::bit_cast<bytes_type>(value);
+    std::ranges::reverse(bytes);
+    return bytes;
+  }
+}
+
+// Inverse of to_buffer_bytes
+template<std::endian BufferEndian, NetworkSerializableBasic T>
+constexpr T from_buffer_bytes(const std::array<std::uint8_t, sizeof(T)>& bytes) noexcept
+{
+  if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
+    return std::bit_cast<T>(bytes);
+  } else if constexpr (requires { typename unsigned_of_size<sizeof(T)>::type; }) {
+    using U = typename unsigned_of_size<sizeof(T)>::type;
+    return std::bit_cast<T>(byteswap(std::bit_cast<U>(bytes)));
+  } else {
+    auto reversed = bytes;
+    std::ranges::reverse(reversed);
+    return std::bit_cast<T>(reversed);
+  }
+}
+
+// Copies the elements to `dest` with endianness conversion (no bounds check)
+template<std::endian BufferEndian, NetworkSerializableBasic T>
+void store_elements(std::uint8_t* dest, const T* elements, const std::size_t count) noexcept
+{
+  if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
+    std::memcpy(dest, elements, count * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < count; ++i, dest += sizeof(T)) {
+      const auto bytes = to_buffer_bytes<BufferEndian>(elements[i]);
+      std::memcpy(dest, bytes.data(), sizeof(T));
+    }
+  }
+}
+
+// Copies the elements from `src` with endianness conversion (no bounds check)
+template<std::endian BufferEndian, NetworkSerializableBasic T>
+void load_elements(const std::uint8_t* src, T* elements, const std::size_t count) noexcept
+{
+  if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
+    std::memcpy(elements, src, count * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < count; ++i, src += sizeof(T)) {
+      std::array<std::uint8_t, sizeof(T)> bytes;
+      std::memcpy(bytes.data(), src, sizeof(T));
+      elements[i] = from_buffer_bytes<BufferEndian, T>(bytes);
+    }
+  }
+}
+
+template<std::endian BufferEndian, NetworkSerializableFixedSize T>
+void store_field(std::uint8_t* dest, const T& value) noexcept
+{
+  if constexpr (NetworkSerializableBasic<T>) {
+    store_elements<BufferEndian>(dest, &value, 1);
+  } else if constexpr (NetworkSerializableBasicArray<T>) {
+    store_elements<BufferEndian>(dest, value, std::extent_v<T>);
+  } else {
+    store_elements<BufferEndian>(dest, value.data(), value.size());
+  }
+}
+
+template<std::endian BufferEndian, NetworkSerializableFixedSize T>
+void load_field(const std::uint8_t* src, T& value) noexcept
+{
+  if constexpr (NetworkSerializableBasic<T>) {
+    load_elements<BufferEndian>(src, &value, 1);
+  } else if constexpr (NetworkSerializableBasicArray<T>) {
+    load_elements<BufferEndian>(src, value, std::extent_v<T>);
+  } else {
+    load_elements<BufferEndian>(src, value.data(), value.size());
+  }
+}
+
+} // namespace detail
+
+/**
+ * @struct bit_packed
+ * @brief Frame-of-reference + bit-packing encoding for integer arrays with a small range (counters, ADC readings).
+ * Values are encoded in blocks of `block_size<T>` values (128 for integers up to 32 bits, 256 for 64-bit integers).
+ * Each block stores its minimum (base, `T`) and the bit width of its largest delta (`std::uint8_t`), followed by the
+ * deltas from the base packed in `width` bits each:
+ * - Full blocks: four interleaved lanes (value i is in lane i % 4) packed into `4 * width` words (`word_type<T>`,
+ *   32 or 64 bits) in the endianness of the stream. The 32-bit word kernels are unrolled per width and vectorized
+ *   by the compiler; 64-bit words are packed row by row.
+ * - The last, partial block: `ceil(count * width / 8)` bytes, least significant bit first.
+ *
+ * Usage: `stream.write<bytepack::bit_packed>(vec);` and `stream.read<bytepack::bit_packed>(vec);`
+ */
+struct bit_packed
+{
+  template<typename T>
+  using word_type = std::conditional_t<sizeof(T) <= 4, std::uint32_t, std::uint64_t>;
+
+  template<typename T>
+  static constexpr std::size_t block_size = 4 * 8 * sizeof(word_type<T>);
+};
+
+template<typename T>
+concept BitPackableInteger = std::is_integral_v<T> && std::same_as<T, bool> == false;
+
+namespace detail {
+
+// Row `Rows` of a full block (values 4 * Rows ... 4 * Rows + 3, one per lane) starts at bit Rows * Width of the lane
+// words. The rows are expanded from a parameter pack, so the word indices and shifts are constants and the lane loops
+// compile to vector shifts.
+template<typename Word, unsigned Width, unsigned... Rows>
+void pack_rows(const Word* in, Word* out, std::integer_sequence<unsigned, Rows...>) noexcept
+{
+  constexpr unsigned bits = 8 * sizeof(Word);
+  // Working on a copy tells the compiler that the stores to `out` do not change the input
+  Word values[4 * bits];
+  std::memcpy(values, in, sizeof(values));
+  for (unsigned lane = 0; lane < 4; ++lane) {
+    // A word is stored when its last row is added; the bits that spill over start the next word
+    Word acc = 0;
+    ((acc |= static_cast<Word>(values[4 * Rows + lane] << Rows * Width % bits),
+      Rows * Width % bits + Width >= bits
+        ? (void)(out[4 * (Rows * Width / bits) + lane] = acc,
+                 acc = Rows * Width % bits + Width > bits
+                         ? static_cast<Word>(values[4 * Rows + lane] >> (bits - Rows * Width % bits) % bits)
+                         : Word{ 0 })
+        : (void)0),
+     ...);
+  }
+}
+
+template<typename Word, unsigned Width, unsigned... Rows>
+void unpack_rows(const Word* in, Word* out, std::integer_sequence<unsigned, Rows...>) noexcept
+{
+  constexpr unsigned bits = 8 * sizeof(Word);
+  constexpr Word mask = static_cast<Word>((Word{ 1 } << Width) - 1);
+  // A row that spills over takes its high bits from the next word. `% bits` keeps the shift counts of rows that do
+  // not spill in range, although their branch is never taken.
+  for (unsigned lane = 0; lane < 4; ++lane) {
+    ((out[4 * Rows + lane] = static_cast<Word>(
+        (static_cast<Word>(in[4 * (Rows * Width / bits) + lane] >> Rows * Width % bits)
+         | (Rows * Width % bits + Width > bits
+              ? static_cast<Word>(in[4 * (Rows * Width / bits + 1) + lane] << (bits - Rows * Width % bits) % bits)
+              : Word{ 0 }))
+        & mask)),
+     ...);
+  }
+}
+
+// Same layout as pack_rows with a loop over the rows. Used for 64-bit words: unrolling their 64 rows for every width
+// quadruples the compile time of a translation unit that bit-packs 64-bit values, for about 1.5x the throughput.
+template<typename Word>
+void pack_lanes(const Word* in, Word* out, const unsigned width) noexcept
+{
+  constexpr unsigned bits = 8 * sizeof(Word);
+  // Local copies tell the compiler that the lanes do not alias, so each row is a vector shift
+  Word values[4 * bits];
+  Word words[4 * bits]{};
+  std::memcpy(values, in, sizeof(values));
+  for (unsigned row = 0; row < bits; ++row) {
+    const unsigned word = row * width / bits;
+    const unsigned shift = row * width % bits;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+      words[4 * word + lane] |= static_cast<Word>(values[4 * row + lane] << shift);
+    }
+    if (shift + width > bits) {
+      for (unsigned lane = 0; lane < 4; ++lane) {
+        words[4 * (word + 1) + lane] = static_cast<Word>(values[4 * row + lane] >> (bits - shift));
+      }
+    }
+  }
+  std::memcpy(out, words, 4 * width * sizeof(Word));
+}
+
+template<typename Word>
+void unpack_lanes(const Word* in, Word* out, const unsigned width) noexcept
+{
+  constexpr unsigned bits = 8 * sizeof(Word);
+  const Word mask = static_cast<Word>((Word{ 1 } << width) - 1);
+  for (unsigned row = 0; row < bits; ++row) {
+    const unsigned word = row * width / bits;
+    const unsigned shift = row * width % bits;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+      Word value = static_cast<Word>(in[4 * word + lane] >> shift);
+      if (shift + width > bits) {
+        value |= static_cast<Word>(in[4 * (word + 1) + lane] << (bits - shift));
+      }
+      out[4 * row + lane] = static_cast<Word>(value & mask);
+    }
+  }
+}
+
+// Packs a full block (4 * bits(Word) values, 4 interleaved lanes) into 4 * Width words
+template<typename Word, unsigned Width>
+void pack_block(const Word* in, Word* out) noexcept
+{
+  constexpr unsigned word_bits = 8 * sizeof(Word);
+  if constexpr (Width == word_bits) {
+    std::memcpy(out, in, 4 * word_bits * sizeof(Word));
+  } else if constexpr (sizeof(Word) == 8) {
+    pack_lanes(in, out, Width);
+  } else if constexpr (Width > 0) {
+    pack_rows<Word, Width>(in, out, std::make_integer_sequence<unsigned, word_bits>{});
+  }
+}
+
+// Inverse of pack_block
+template<typename Word, unsigned Width>
+void unpack_block(const Word* in, Word* out) noexcept
+{
+  constexpr unsigned word_bits = 8 * sizeof(Word);
+  if constexpr (Width == word_bits) {
+    std::memcpy(out, in, 4 * word_bits * sizeof(Word));
+  } else if constexpr (Width == 0) {
+    std::fill_n(out, 4 * word_bits, Word{ 0 });
+  } else if constexpr (sizeof(Word) == 8) {
+    unpack_lanes(in, out, Width);
+  } else {
+    unpack_rows<Word, Width>(in, out, std::make_integer_sequence<unsigned, word_bits>{});
+  }
+}
+
+// Kernels indexed by the bit width of a block
+template<typename Word>
+using block_kernel = void (*)(const Word*, Word*) noexcept;
+
+template<typename Word, std::size_t... Widths>
+constexpr std::array<block_kernel<Word>, sizeof...(Widths)> make_pack_kernels(std::index_sequence<Widths...>) noexcept
+{
+  return { &pack_block<Word, static_cast<unsigned>(Widths)>... };
+}
+
+template<typename Word, std::size_t... Widths>
+constexpr std::array<block_kernel<Word>, sizeof...(Widths)> make_unpack_kernels(std::index_sequence<Widths...>) noexcept
+{
+  return { &unpack_block<Word, static_cast<unsigned>(Widths)>... };
+}
+
+// The tables are instantiated on first use, for the widths of deltas of `T` only (e.g. 9 kernels for 8-bit values);
+// reads reject wider widths before dispatching.
+template<BitPackableInteger T>
+inline constexpr auto pack_kernels =
+  make_pack_kernels<bit_packed::word_type<T>>(std::make_index_sequence<8 * sizeof(T) + 1>{});
+
+template<BitPackableInteger T>
+inline constexpr auto unpack_kernels =
+  make_unpack_kernels<bit_packed::word_type<T>>(std::make_index_sequence<8 * sizeof(T) + 1>{});
+
+// Packs values of `width` bits into bytes, least significant bit first (`out` is zero-initialized by the caller)
+template<typename Word>
+void pack_bits(const Word* in, const std::size_t count, const unsigned width, std::uint8_t* out) noexcept
+{
+  std::size_t bit = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    for (unsigned done = 0; done < width;) {
+      const unsigned offset = static_cast<unsigned>(bit % 8);
+      const unsigned take = std::min(8U - offset, width - done);
+      const auto bits = static_cast<unsigned>((in[i] >> done) & ((1U << take) - 1U));
+      out[bit / 8] = static_cast<std::uint8_t>(out[bit / 8] | (bits << offset));
+      done += take;
+      bit += take;
+    }
+  }
+}
+
+template<typename Word>
+void unpack_bits(const std::uint8_t* in, const std::size_t count, const unsigned width, Word* out) noexcept
+{
+  std::size_t bit = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    Word value{ 0 };
+    for (unsigned done = 0; done < width;) {
+      const unsigned offset = static_cast<unsigned>(bit % 8);
+      const unsigned take = std::min(8U - offset, width - done);
+      const auto bits = static_cast<Word>((in[bit / 8] >> offset) & ((1U << take) - 1U));
+      value = static_cast<Word>(value | static_cast<Word>(bits << done));
+      done += take;
+      bit += take;
+    }
+    out[i] = value;
+  }
+}
+
+} // namespace detail
+
+/**
+ * @struct no_instrumentation
+ * @brief Default instrumentation policy of binary_stream: nothing is counted and no per-stream state is stored.
+ *
+ * Policies with `enabled = true` provide static hooks called by the stream:
+ * - `on_begin(const stream_state&, std::size_t buffer_size)`: construction and `reset()`
+ * - `on_end(const stream_state&, std::size_t written, std::size_t read, std::size_t buffer_size)`: `reset()` and
+ *   destruction
+ * - `on_failure(error_code, std::size_t offset, const std::source_location&)`: every failed read/write
+ * - `on_bulk_copy(bool is_write, std::size_t offset, std::size_t size)`: array, vector and string data copies
+ */
+struct no_instrumentation
+{
+  static constexpr bool enabled = false;
+
+  struct stream_state
+  {};
+};
+
+/**
+ * @struct stream_statistics
+ * @brief Instrumentation policy that aggregates binary_stream counters of the calling thread in thread-local storage.
+ *
+ * A stream cycle (serialization or deserialization of a message) is recorded when the stream is `reset()` or
+ * destroyed: bytes written/read, peak buffer utilization and, if the stream was tagged with `set_message_type()`, the
+ * serialized size per message type. Failures are counted by error code and by the failing read/write function.
+ * The hooks do not allocate: the per-function and per-message-type tables have a fixed capacity, and further keys are
+ * only counted in their `dropped` counter.
+ *
+ * Usage: `bytepack::binary_stream<std::endian::big, bytepack::stream_statistics> stream(1024);`
+ * then `auto stats = bytepack::stream_statistics::snapshot();`
+ */
+struct stream_statistics
+{
+  static constexpr bool enabled = true;
+
+  struct stream_state
+  {
+    std::optional<std::uint32_t> message_type;
+  };
+
+  static constexpr std::size_t max_failing_functions = 32;
+  static constexpr std::size_t max_message_types = 64;
+
+  // Fixed-capacity map with linear lookup in insertion order
+  template<typename Key, typename Value, std::size_t Capacity>
+  struct bounded_map
+  {
+    std::array<Key, Capacity> keys{};
+    std::array<Value, Capacity> values{};
+    std::size_t count{ 0 };
+    std::uint64_t dropped{ 0 }; // Updates of keys that did not fit
+
+    [[nodiscard]] std::size_t size() const noexcept { return count; }
+
+    [[nodiscard]] const Value* find(const Key& key) const noexcept
+    {
+      const std::size_t i = index_of(key);
+      return i < count ? &values[i] : nullptr;
+    }
+
+    // Returns nullptr (and counts the update as dropped) if the key is new and the map is full
+    Value* find_or_insert(const Key& key) noexcept
+    {
+      const std::size_t i = index_of(key);
+      if (i < count) {
+        return &values[i];
+      }
+      if (count == Capacity) {
+        ++dropped;
+        return nullptr;
+      }
+      keys[count] = key;
+      values[count] = Value{};
+      return &values[count++];
+    }
+
+  private:
+    [[nodiscard]] std::size_t index_of(const Key& key) const noexcept
+    {
+      std::size_t i = 0;
+      while (i < count && keys[i] != key) {
+        ++i;
+      }
+      return i;
+    }
+  };
+
+  struct message_size
+  {
+    std::uint64_t count{ 0 };
+    std::uint64_t total_bytes{ 0 };
+    std::size_t max_bytes{ 0 };
+  };
+
+  struct counters
+  {
+    std::uint64_t cycles{ 0 };
+    std::uint64_t bytes_written{ 0 };
+    std::uint64_t bytes_read{ 0 };
+    std::size_t peak_bytes_written{ 0 };
+    double peak_utilization{ 0.0 }; // Highest ratio of written bytes to buffer size [0, 1]
+    std::uint64_t bulk_copies{ 0 }; // Array, vector and string data copies
+    std::uint64_t bulk_bytes{ 0 };
+    std::array<std::uint64_t, 6> failures{}; // Indexed by error_code
+    // By signature of the failing read/write function (`std::source_location::function_name()`)
+    bounded_map<const char*, std::uint64_t, max_failing_functions> failures_by_function;
+    // By message type given to set_message_type()
+    bounded_map<std::uint32_t, message_size, max_message_types> message_sizes;
+
+    [[nodiscard]] std::uint64_t failure_count(const error_code code) const noexcept
+    {
+      return failures[static_cast<std::size_t>(code)];
+    }
+
+    // Merges counters, e.g. snapshots of different threads
+    counters& operator+=(const counters& other)
+    {
+      cycles += other.cycles;
+      bytes_written += other.bytes_written;
+      bytes_read += other.bytes_read;
+      peak_bytes_written = std::max(peak_bytes_written, other.peak_bytes_written);
+      peak_utilization = std::max(peak_utilization, other.peak_utilization);
+      bulk_copies += other.bulk_copies;
+      bulk_bytes += other.bulk_bytes;
+      for (std::size_t i = 0; i < failures.size(); ++i) {
+        failures[i] += other.failures[i];
+      }
+      for (std::size_t i = 0; i < other.failures_by_function.size(); ++i) {
+        if (std::uint64_t* merged = failures_by_function.find_or_insert(other.failures_by_function.keys[i]);
+            merged != nullptr) {
+          *merged += other.failures_by_function.values[i];
+        }
+      }
+      failures_by_function.dropped += other.failures_by_function.dropped;
+      for (std::size_t i = 0; i < other.message_sizes.size(); ++i) {
+        const message_size& size = other.message_sizes.values[i];
+        if (message_size* merged = message_sizes.find_or_insert(other.message_sizes.keys[i]); merged != nullptr) {
+          merged->count += size.count;
+          merged->total_bytes += size.total_bytes;
+          merged->max_bytes = std::max(merged->max_bytes, size.max_bytes);
+        }
+      }
+      message_sizes.dropped += other.message_sizes.dropped;
+      return *this;
+    }
+  };
+
+  /**
+   * @brief Returns a copy of the counters of the calling thread.
+   */
+  [[nodiscard]] static counters snapshot() { return local(); }
+
+  /**
+   * @brief Clears the counters of the calling thread.
+   */
+  static void clear() noexcept { local() = counters{}; }
+
+  static void on_begin(const stream_state&, const std::size_t) noexcept {}
+
+  static void on_end(const stream_state& state, const std::size_t written, const std::size_t read,
+                       const std::size_t buffer_size) noexcept
+  {
+    if (written == 0 && read == 0) {
+      return;
+    }
+
+    counters& c = local();
+    ++c.cycles;
+    c.bytes_written += written;
+    c.bytes_read += read;
+    c.peak_bytes_written = std::max(c.peak_bytes_written, written);
+    if (buffer_size != 0) {
+      c.peak_utilization =
+        std::max(c.peak_utilization, static_cast<double>(written) / static_cast<double>(buffer_size));
+    }
+    if (state.message_type.has_value()) {
+      if (message_size* size = c.message_sizes.find_or_insert(*state.message_type); size != nullptr) {
+        const std::size_t bytes = std::max(written, read);
+        ++size->count;
+        size->total_bytes += bytes;
+        size->max_bytes = std::max(size->max_bytes, bytes);
+      }
+    }
+  }
+
+  static void on_failure(const error_code code, const std::size_t, const std::source_location& location) noexcept
+  {
+    counters& c = local();
+    ++c.failures[static_cast<std::size_t>(code)];
+    if (std::uint64_t* count = c.failures_by_function.find_or_insert(location.function_name()); count != nullptr) {
+      ++*count;
+    }
+  }
+
+  static void on_bulk_copy(const bool, const std::size_t, const std::size_t size) noexcept
+  {
+    counters& c = local();
+    ++c.bulk_copies;
+    c.bulk_bytes += size;
+  }
+
+private:
+  static counters& local() noexcept
+  {
+    thread_local counters thread_counters;
+    return thread_counters;
+  }
+};
+
+template<typename T>
+concept StreamInstrumentation =
+  requires { typename T::stream_state; } && std::same_as<decltype(T::enabled), const bool>;
+
+/**
+ * @class flat_vector
+ * @brief A sequence of variable-length arrays (or strings) stored in a single contiguous buffer.
+ *
+ * It has the same serialized format as `std::vector<std::vector<T>>` (or `std::vector<std::string>` for `char`).
+ * Deserializing into a flat_vector validates all lengths in a single pass first and then copies all inner arrays into
+ * one backing buffer, instead of allocating each inner array separately. Inner arrays are accessed as views
+ * (`std::string_view` for `char`, otherwise `std::span<const T>`), which are valid until the flat_vector is modified.
+ *
+ * @tparam T Element type of the inner arrays.
+ */
+template<NetworkSerializableBasic T>
+class flat_vector
+{
+public:
+  using value_type = T;
+  using view_type = std::conditional_t<std::is_same_v<T, char>, std::string_view, std::span<const T>>;
+
+  [[nodiscard]] std::size_t size() const noexcept { return offsets_.size() - 1; }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] view_type operator[](const std::size_t index) const noexcept
+  {
+    return view_type(data_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  /**
+   * @brief All elements of the inner arrays in a single contiguous view.
+   */
+  [[nodiscard]] std::span<const T> elements() const noexcept { return data_; }
+
+  void push_back(const view_type value)
+  {
+    data_.insert(data_.end(), value.begin(), value.end());
+    offsets_.push_back(data_.size());
+  }
+
+  void clear() noexcept
+  {
+    data_.clear();
+    offsets_.resize(1);
+  }
+
+  void reserve(const std::size_t count, const std::size_t total_elements)
+  {
+    offsets_.reserve(count + 1);
+    data_.reserve(total_elements);
+  }
+
+private:
+  template<std::endian, StreamInstrumentation, bool>
+  friend class binary_stream;
+
+  std::vector<T> data_;
+  std::vector<std::size_t> offsets_{ 0 }; // offsets_[i] is the first element of the i-th array, size() + 1 entries
+};
+
+/**
+ * @class binary_stream
+ * @brief A class for serializing and deserializing binary data with support for different endianness.
+ * It supports handling both internally allocated buffers and user-supplied buffers.
+ *
+ * @tparam BufferEndian The endianness to use for serialization and deserialization.
+ *                      Defaults to big-endian (network byte order).
+ * @tparam Instrumentation Statistics policy (e.g. `stream_statistics`). The default `no_instrumentation` has no
+ *                         runtime or size overhead.
+ * @tparam ReadOnly If true, only the read API is available (any write fails to compile) and the stream can be
+ *                  constructed over immutable memory (`const_buffer_view`). See `binary_reader`.
+ */
+template<std::endian BufferEndian = std::endian::big, StreamInstrumentation Instrumentation = no_instrumentation,
+         bool ReadOnly = false>
+class binary_stream final
+{
+public:
+  // Alignment of internally allocated buffers in bytes (cache line size)
+  static constexpr std::size_t buffer_alignment = 64;
+
+  /**
+   * @param error_mode In `ErrorMode::Sticky` mode, sequential reads/writes after the first failure become no-ops, so a
+   *                   sequence of fields can be serialized without checking each call and `error()` is checked once.
+   */
+  explicit binary_stream(const std::size_t buffer_size, const ErrorMode error_mode = ErrorMode::Default) noexcept
+  requires(ReadOnly == false)
+    : buffer_{ new (std::align_val_t{ buffer_alignment }) std::uint8_t[buffer_size]{}, buffer_size },
+      owns_buffer_{ true }, write_index_{ 0 }, read_index_{ 0 }, capacity_{ buffer_size }, error_mode_{ error_mode }
+  {
+    begin_cycle();
+  }
+
+  explicit constexpr binary_stream(const bytepack::buffer_view& buffer,
+                                   const ErrorMode error_mode = ErrorMode::Default) noexcept
+    : buffer_{ buffer }, owns_buffer_{ false }, write_index_{ 0 }, read_index_{ 0 }, capacity_{ buffer.size() },
+      error_mode_{ error_mode }
+  {
+    begin_cycle();
+  }
+
+  // The data is never written through a read-only stream, so the const_cast is safe
+  explicit constexpr binary_stream(const bytepack::const_buffer_view& buffer,
+                                   const ErrorMode error_mode = ErrorMode::Default) noexcept
+  requires ReadOnly
+    : buffer_{ const_cast<void*>(buffer.as<void>()), buffer.size() }, owns_buffer_{ false }, write_index_{ 0 },
+      read_index_{ 0 }, capacity_{ buffer.size() }, error_mode_{ error_mode }
+  {
+    begin_cycle();
+  }
+
+  ~binary_stream() noexcept
+  {
+    record_cycle();
+    if (owns_buffer_) {
+      ::operator delete[](buffer_.as<void>(), std::align_val_t{ buffer_alignment });
+    }
+  }
+
+  binary_stream(const binary_stream&) = delete;
+  binary_stream& operator=(const binary_stream&) = delete;
+  binary_stream(binary_stream&&) = delete;
+  binary_stream& operator=(binary_stream&&) = delete;
+
+  /**
+   * @brief Resets internal indices for serialization and deserialization, and clears the error state.
+   */
+  constexpr void reset() noexcept
+  {
+    record_cycle();
+    write_index_ = 0;
+    read_index_ = 0;
+    capacity_ = buffer_.size();
+    error_ = stream_error{};
+    begin_cycle();
+  }
+
+  /**
+   * @brief Returns the first error since construction or the last `reset()`. Partial field access (`read_field` and
+   * `write_field`) does not change the error state.
+   */
+  [[nodiscard]] constexpr stream_error error() const noexcept { return error_; }
+
+  /**
+   * @brief Records an error detected by a format layered on the stream (e.g. an invalid frame type in `delta.hpp`),
+   * with the same rules as the errors of the stream: only the first error is kept, and sticky mode fails all later
+   * reads/writes. Returns false, so it can be returned directly.
+   */
+  constexpr bool set_error(const error_code code, const std::size_t offset,
+                           const std::source_location location = std::source_location::current()) noexcept
+  {
+    return fail(code, offset, location);
+  }
+
+  /**
+   * @brief Tags the current message for per-message-type size statistics. It has no effect without instrumentation.
+   */
+  constexpr void set_message_type([[maybe_unused]] const std::uint32_t message_type) noexcept
+  {
+    if constexpr (Instrumentation::enabled) {
+      instrumentation_state_.message_type = message_type;
+    }
+  }
+
+  [[nodiscard]] bytepack::buffer_view data() const noexcept
+  requires(ReadOnly == false)
+  {
+    return bytepack::buffer_view(buffer_.as<std::uint8_t>(), write_index_);
+  }
+
+  // The memory of a binary_reader may be read-only, so it is only exposed as a const_buffer_view
+  [[nodiscard]] bytepack::const_buffer_view data() const noexcept
+  requires ReadOnly
+  {
+    return bytepack::const_buffer_view(buffer_.as<const std::uint8_t>(), write_index_);
+  }
+
+  /**
+   * @brief Returns the byte offset of the next sequential read (the number of bytes read so far).
+   */
+  [[nodiscard]] constexpr std::size_t read_offset() const noexcept { return read_index_; }
+
+  template<NetworkSerializableBasic T>
+  bool write(const T& value) noexcept
+  {
+    if (capacity_ < (write_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    // Endianness conversion uses shift-based byte swaps (detail::byteswap), a platform-independent alternative to
+    // htonl/htons/ntohl/ntohs. Benchmark link: https://quick-bench.com/q/va-kzUk1J1BfvSgR05Z1YPnrJhg
+    store_elements(write_index_, &value, 1);
+    write_index_ += sizeof(T);
+
+    return true;
+  }
+
+  template<NetworkSerializableBasicArray T>
+  bool write(const T& value) noexcept
+  {
+    using ElementType = std::remove_extent_t<T>;
+    constexpr std::size_t elementSize = sizeof(ElementType);
+    constexpr std::size_t numElements = sizeof(T) / elementSize;
+
+    // Check if there is enough space in the buffer for the entire array
+    if (capacity_ < (write_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    write_elements(value, numElements);
+    return true;
+  }
+
+  template<typename T, std::size_t N>
+  requires NetworkSerializableBasic<T>
+  bool write(const std::array<T, N>& array) noexcept
+  {
+    if (capacity_ < (write_index_ + N * sizeof(T))) {
+      // Array elements cannot fit in the remaining buffer space
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    write_elements(array.data(), N);
+    return true;
+  }
+
+  /**
+   * @brief Writes already serialized bytes as they are (no size field, no byte order conversion). Nothing is written
+   * if they do not fit.
+   */
+  bool write_bytes(const bytepack::const_buffer_view& bytes) noexcept
+  {
+    if (capacity_ < (write_index_ + bytes.size())) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    if (bytes.size() > 0) {
+      write_elements(bytes.as<std::uint8_t>(), bytes.size());
+    }
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t, typename T>
+  requires NetworkSerializableBasic<T>
+  bool write(const std::vector<T>& vector) noexcept
+  {
+    // When serializing dynamic size containers (if fixed size is not given), always include the container's size as
+    // metadata before the container data. This is crucial even for empty containers, as it allows the deserializer to
+    // accurately determine if the container is empty or contains data.
+    if (capacity_ < (write_index_ + sizeof(SizeType) + vector.size() * sizeof(T))) {
+      // Vector size field and its elements cannot fit in the remaining buffer space
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    const auto size_custom = static_cast<SizeType>(vector.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != vector.size()) {
+      // Overflow or incorrect size type
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    // Write vector size field first (before the vector data)
+    if (write(size_custom) == false) {
+      return false;
+    }
+
+    write_elements(vector.data(), vector.size());
+    return true;
+  }
+
+  template<std::size_t N, typename T>
+  requires NetworkSerializableBasic<T>
+  bool write(const std::vector<T>& vector) noexcept
+  {
+    if (vector.size() < N) {
+      return fail(error_code::invalid_size, write_index_);
+    }
+
+    if (capacity_ < (write_index_ + N * sizeof(T))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    write_elements(vector.data(), N);
+    return true;
+  }
+
+  /**
+   * @brief Writes a wire-compatible struct with a single copy (see WireStruct).
+   */
+  template<WireStruct T>
+  bool write(const T& value) noexcept
+  {
+    static_assert(detail::check_wire_struct<T, BufferEndian>());
+    if (capacity_ < (write_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    write_wire_structs(&value, 1);
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t, WireStruct T>
+  bool write(const std::vector<T>& vector) noexcept
+  {
+    static_assert(detail::check_wire_struct<T, BufferEndian>());
+    if (capacity_ < (write_index_ + sizeof(SizeType) + vector.size() * sizeof(T))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    const auto size_custom = static_cast<SizeType>(vector.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != vector.size()) {
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    if (write(size_custom) == false) {
+      return false;
+    }
+
+    write_wire_structs(vector.data(), vector.size());
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t, NetworkSerializableString StringType>
+  bool write(const StringType& value) noexcept
+  {
+    const auto str_length = static_cast<SizeType>(value.length());
+    if ((std::is_signed_v<SizeType> && str_length < 0) || static_cast<std::size_t>(str_length) != value.length()) {
+      // Overflow or incorrect size type
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    if (capacity_ < (write_index_ + sizeof(SizeType) + value.length())) {
+      // String data and its length field cannot fit in the remaining buffer space
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    // Write string length field first (before the string data)
+    if (write(str_length) == false) {
+      return false;
+    }
+
+    write_elements(value.data(), value.length());
+    return true;
+  }
+
+  template<std::size_t N, NetworkSerializableString StringType>
+  bool write(const StringType& value) noexcept
+  {
+    if (capacity_ < (write_index_ + N)) {
+      // Not enough space in the buffer to write the string
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    if (value.length() >= N) {
+      // If the string is longer or equal to the specified length, write only the required part
+      write_elements(value.data(), N);
+    } else {
+      // If the string is shorter, write the string and pad the rest with null characters
+      const std::size_t padding = N - value.length();
+      write_elements(value.data(), value.length());
+      std::memset(buffer_.as<std::uint8_t>() + write_index_, '\0', padding);
+      write_index_ += padding;
+    }
+    return true;
+  }
+
+  template<bytepack::StringMode Mode, NetworkSerializableString StringType>
+  bool write(const StringType& value) noexcept
+  {
+    if constexpr (Mode == bytepack::StringMode::NullTerm) {
+      const std::size_t str_length = value.length() + 1; // +1 for null terminator
+
+      if (capacity_ < (write_index_ + str_length)) {
+        return fail(error_code::buffer_overflow, write_index_);
+      }
+
+      write_elements(value.data(), str_length - 1);
+      buffer_.as<char>()[write_index_] = '\0'; // null terminator
+      ++write_index_;
+    } else {
+      // Fallback to existing method for serialization without null termination
+      return write(value); // Call the existing method for StringType
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Serializes an optional value as a presence byte (0 or 1) followed by the value if present.
+   */
+  template<NetworkSerializableOptional OptionalType>
+  bool write(const OptionalType& value) noexcept
+  {
+    const std::size_t start_index = write_index_;
+    if (write(static_cast<std::uint8_t>(value.has_value())) && (value.has_value() == false || write(*value))) {
+      return true;
+    }
+
+    write_index_ = start_index; // Do not leave a partially serialized optional behind
+    return false;
+  }
+
+  /**
+   * @brief Serializes a variant as its alternative index (tag) followed by the held alternative.
+   *
+   * @tparam TagType Type of the tag field. Defaults to std::uint8_t.
+   */
+  template<IntegralType TagType = std::uint8_t, typename... Ts>
+  requires NetworkSerializableVariant<std::variant<Ts...>>
+  bool write(const std::variant<Ts...>& value) noexcept
+  {
+    const auto tag = static_cast<TagType>(value.index());
+    if (value.valueless_by_exception() || static_cast<std::size_t>(tag) != value.index()) {
+      // Valueless variant or the tag type is too small for the alternative index
+      return fail(error_code::invalid_value, write_index_);
+    }
+
+    const std::size_t start_index = write_index_;
+    if (write(tag) && write_alternative(value, std::index_sequence_for<Ts...>{})) {
+      return true;
+    }
+
+    write_index_ = start_index;
+    return false;
+  }
+
+  /**
+   * @brief Serializes std::deque, std::list, std::map, std::unordered_map and sorted vectors of key-value pairs
+   * (std::flat_map-style) with the element count prefixed. Map entries are serialized as key followed by value, in the
+   * iteration order of the container (sorted for std::map).
+   *
+   * Vectors of pairs whose keys are not strictly increasing are rejected, as they are on read.
+   *
+   * @tparam SizeType Type of the element count field. Defaults to std::uint32_t.
+   */
+  template<IntegralType SizeType = std::uint32_t, NetworkSerializableContainer ContainerType>
+  bool write(const ContainerType& container) noexcept
+  {
+    const auto size_custom = static_cast<SizeType>(container.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != container.size()) {
+      // Overflow or incorrect size type
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    if constexpr (NetworkSerializableFlatMap<ContainerType>) {
+      const auto unsorted = std::ranges::adjacent_find(
+        container, [](const auto& previous, const auto& next) { return !(previous.first < next.first); });
+      if (unsorted != container.end()) {
+        return fail(error_code::invalid_value, write_index_); // unsorted or duplicate key
+      }
+    }
+
+    const std::size_t start_index = write_index_;
+    if (write(size_custom) == false) {
+      return false;
+    }
+
+    for (const auto& element : container) {
+      bool written = false;
+      if constexpr (NetworkSerializableSequence<ContainerType>) {
+        written = write(element);
+      } else {
+        written = write(element.first) && write(element.second);
+      }
+
+      if (written == false) {
+        write_index_ = start_index; // Do not leave a partially serialized container behind
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Serializes a flat_vector in the same format as `std::vector<std::vector<T>>` / `std::vector<std::string>`.
+   *
+   * @tparam SizeType Type of the array count field. Defaults to std::uint32_t.
+   * @tparam InnerSizeType Type of the length field of each inner array. Defaults to std::uint32_t.
+   */
+  template<IntegralType SizeType = std::uint32_t, IntegralType InnerSizeType = std::uint32_t, typename T>
+  bool write(const flat_vector<T>& value) noexcept
+  {
+    const auto size_custom = static_cast<SizeType>(value.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != value.size()) {
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    const std::size_t start_index = write_index_;
+    if (write(size_custom) == false) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      const auto inner = value[i];
+      const auto inner_size = static_cast<InnerSizeType>(inner.size());
+      if ((std::is_signed_v<InnerSizeType> && inner_size < 0) || static_cast<std::size_t>(inner_size) != inner.size()) {
+        const std::size_t failed_index = write_index_;
+        write_index_ = start_index;
+        return fail(error_code::size_overflow, failed_index);
+      }
+      if (capacity_ < (write_index_ + sizeof(InnerSizeType) + inner.size() * sizeof(T))) {
+        const std::size_t failed_index = write_index_;
+        write_index_ = start_index;
+        return fail(error_code::buffer_overflow, failed_index);
+      }
+
+      store_elements(write_index_, &inner_size, 1);
+      write_index_ += sizeof(InnerSizeType);
+      store_elements(write_index_, inner.data(), inner.size());
+      write_index_ += inner.size() * sizeof(T);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Serializes a floating-point value with the given encoding (e.g. float16, bfloat16, fixed_point).
+   */
+  template<FloatEncoding Encoding, std::floating_point T>
+  bool write(const T& value) noexcept
+  {
+    return write_encoded<Encoding>(&value, 1);
+  }
+
+  template<FloatEncoding Encoding, std::floating_point T, std::size_t N>
+  bool write(const T (&array)[N]) noexcept
+  {
+    return write_encoded<Encoding>(array, N);
+  }
+
+  template<FloatEncoding Encoding, std::floating_point T, std::size_t N>
+  bool write(const std::array<T, N>& array) noexcept
+  {
+    return write_encoded<Encoding>(array.data(), N);
+  }
+
+  template<FloatEncoding Encoding, IntegralType SizeType = std::uint32_t, std::floating_point T>
+  bool write(const std::vector<T>& vector) noexcept
+  {
+    if (capacity_ < (write_index_ + sizeof(SizeType) + vector.size() * sizeof(typename Encoding::wire_type))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    const auto size_custom = static_cast<SizeType>(vector.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != vector.size()) {
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    return write(size_custom) && write_encoded<Encoding>(vector.data(), vector.size());
+  }
+
+  /**
+   * @brief Serializes an integer array with frame-of-reference + bit-packing (see bit_packed).
+   */
+  template<std::same_as<bit_packed> Encoding, BitPackableInteger T, std::size_t N>
+  bool write(const T (&array)[N]) noexcept
+  {
+    return write_bit_packed(array, N);
+  }
+
+  template<std::same_as<bit_packed> Encoding, BitPackableInteger T, std::size_t N>
+  bool write(const std::array<T, N>& array) noexcept
+  {
+    return write_bit_packed(array.data(), N);
+  }
+
+  template<std::same_as<bit_packed> Encoding, IntegralType SizeType = std::uint32_t, BitPackableInteger T>
+  bool write(const std::vector<T>& vector) noexcept
+  {
+    const auto size_custom = static_cast<SizeType>(vector.size());
+    if ((std::is_signed_v<SizeType> && size_custom < 0) || static_cast<std::size_t>(size_custom) != vector.size()) {
+      return fail(error_code::size_overflow, write_index_);
+    }
+
+    const std::size_t start_index = write_index_;
+    if (write(size_custom) && write_bit_packed(vector.data(), vector.size())) {
+      return true;
+    }
+    write_index_ = start_index;
+    return false;
+  }
+
+  /**
+   * @brief Serializes multiple optional values as a presence bitmap (one bit per optional, ceil(N / 8) bytes, least
+   * significant bit first) followed by the present values.
+   */
+  template<NetworkSerializableOptional... OptionalTypes>
+  bool write_optionals(const OptionalTypes&... values) noexcept
+  {
+    std::array<std::uint8_t, (sizeof...(OptionalTypes) + 7) / 8> presence{};
+    std::size_t bit = 0;
+    ((presence[bit / 8] |= static_cast<std::uint8_t>(values.has_value() ? 1U << (bit % 8) : 0U), ++bit), ...);
+
+    const std::size_t start_index = write_index_;
+    if (write(presence) && (... && (values.has_value() == false || write(*values)))) {
+      return true;
+    }
+
+    write_index_ = start_index;
+    return false;
+  }
+
+  template<NetworkSerializableType FirstArg, NetworkSerializableType... Args>
+  bool write(const FirstArg& firstArg, const Args&... args) noexcept
+  {
+    return write(firstArg) && (... && write(args));
+  }
+
+  // TODO: Currently, the serialization of std::wstring and std::wstring_view is not supported
+  // due to the variation in wchar_t size across platforms (e.g., 2 bytes on Windows, 4 bytes on Unix/Linux).
+  // A future enhancement could involve standardizing on a character encoding like UTF-8 for network
+  // transmission and handling the conversion from/to std::wstring while considering platform differences.
+  // This would ensure consistent behavior across different systems and avoid issues with wchar_t size discrepancies.
+  // For now, users can use std::string and std::string_view for string serialization.
+
+  template<NetworkSerializableBasic T>
+  bool read(T& value) noexcept
+  {
+    if (capacity_ < (read_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    load_elements(read_index_, &value, 1);
+    read_index_ += sizeof(T);
+
+    return true;
+  }
+
+  template<NetworkSerializableBasicArray T>
+  bool read(T& value) noexcept
+  {
+    using ElementType = std::remove_extent_t<T>;
+    constexpr std::size_t elementSize = sizeof(ElementType);
+    constexpr std::size_t numElements = sizeof(T) / elementSize;
+
+    // Check if there is enough data in the buffer to read the entire array
+    if (capacity_ < (read_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    read_elements(value, numElements);
+    return true;
+  }
+
+  template<typename T, std::size_t N>
+  requires NetworkSerializableBasic<T>
+  bool read(std::array<T, N>& array) noexcept
+  {
+    // Check if there is enough data in the buffer to read the entire array
+    if (capacity_ < (read_index_ + N * sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    read_elements(array.data(), N);
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t, typename T>
+  requires NetworkSerializableBasic<T>
+  bool read(std::vector<T>& vector) noexcept
+  {
+    SizeType size_custom{};
+    // vector size cannot be negative, so it's treated as an error. Zero size is well-defined for dynamic containers if
+    // they are not serialized with a given fixed size because it indicates an empty container.
+    if (read(size_custom) == false) {
+      return false;
+    }
+    if (size_custom < 0) {
+      return fail(error_code::invalid_size, read_index_ - sizeof(SizeType));
+    }
+    const auto size = static_cast<std::size_t>(size_custom);
+
+    if (capacity_ < (read_index_ + size * sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    vector.resize(size);
+
+    read_elements(vector.data(), size);
+    return true;
+  }
+
+  template<WireStruct T>
+  bool read(T& value) noexcept
+  {
+    static_assert(detail::check_wire_struct<T, BufferEndian>());
+    if (capacity_ < (read_index_ + sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    read_wire_structs(&value, 1);
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t, WireStruct T>
+  bool read(std::vector<T>& vector) noexcept
+  {
+    static_assert(detail::check_wire_struct<T, BufferEndian>());
+    SizeType size_custom{};
+    if (read(size_custom) == false) {
+      return false;
+    }
+    if (size_custom < 0) {
+      return fail(error_code::invalid_size, read_index_ - sizeof(SizeType));
+    }
+    const auto size = static_cast<std::size_t>(size_custom);
+
+    if (capacity_ < (read_index_ + size * sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    vector.resize(size);
+
+    read_wire_structs(vector.data(), size);
+    return true;
+  }
+
+  template<std::size_t N, typename T>
+  requires NetworkSerializableBasic<T>
+  bool read(std::vector<T>& vector) noexcept
+  {
+    if (capacity_ < (read_index_ + N * sizeof(T))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    vector.resize(N);
+
+    read_elements(vector.data(), N);
+    return true;
+  }
+
+  template<IntegralType SizeType = std::uint32_t>
+  bool read(std::string& value) noexcept
+  {
+    if (capacity_ < (read_index_ + sizeof(SizeType))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    // Temporarily read string length without incrementing deserialize index
+    SizeType str_length{};
+    std::memcpy(&str_length, buffer_.as<std::uint8_t>() + read_index_, sizeof(SizeType));
+
+    // Handle endianness for the string length
+    if constexpr (BufferEndian != std::endian::native && sizeof(SizeType) > 1) {
+      std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&str_length),
+                           reinterpret_cast<std::uint8_t*>(&str_length) + sizeof(SizeType));
+    }
+
+    // String length cannot be negative, so it's treated as an error. Zero length is well-defined for dynamic strings if
+    // they are not serialized with a given fixed length because it indicates an empty string.
+    if (str_length < 0) {
+      return fail(error_code::invalid_size, read_index_);
+    }
+
+    if (capacity_ < (read_index_ + sizeof(SizeType) + static_cast<std::size_t>(str_length))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    // Alternative approach in case of performance issues: first resize the string to the required size
+    // using `value.resize(str_length)` and then copy the string data using `std::memcpy(value.data(), ...)`
+    read_index_ += sizeof(SizeType);
+    trace_bulk_copy(false, read_index_, static_cast<std::size_t>(str_length));
+    value.assign(buffer_.as<char>() + read_index_, static_cast<std::size_t>(str_length));
+
+    read_index_ += static_cast<std::size_t>(str_length);
+
+    return true;
+  }
+
+  /**
+   * @brief Reads a length-prefixed string without copying it: the view refers to the buffer of the stream and is valid
+   * as long as the buffer.
+   */
+  template<IntegralType SizeType = std::uint32_t>
+  bool read(std::string_view& value) noexcept
+  {
+    if (capacity_ < (read_index_ + sizeof(SizeType))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    SizeType str_length{};
+    load_elements(read_index_, &str_length, 1);
+
+    if (str_length < 0) {
+      return fail(error_code::invalid_size, read_index_);
+    }
+
+    if (capacity_ < (read_index_ + sizeof(SizeType) + static_cast<std::size_t>(str_length))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    value = std::string_view(buffer_.as<char>() + read_index_ + sizeof(SizeType), static_cast<std::size_t>(str_length));
+    read_index_ += sizeof(SizeType) + static_cast<std::size_t>(str_length);
+
+    return true;
+  }
+
+  template<std::size_t N>
+  bool read(std::string& value) noexcept
+  {
+    if (capacity_ < (read_index_ + N)) {
+      // Not enough data in the buffer to read the string
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    trace_bulk_copy(false, read_index_, N);
+    value.assign(buffer_.as<char>() + read_index_, N);
+
+    // TODO: This code uses `value.find('\0')` for a linear search to locate the first null character, suitable for
+    // shorter strings. For longer strings, especially when nulls are at the end, first checking the last character for
+    // null can optimize performance. If it's not null, we can avoid the search entirely. Otherwise, a binary
+    // search-like method is more efficient for such strings, as it exponentially narrows the search space, quickly
+    // finding the initial null character, thus enhancing performance for longer lengths.
+    if (const std::size_t null_pos = value.find('\0'); null_pos != std::string::npos) {
+      // If the string in the buffer is null-terminated, resize the string to the actual length
+      value.resize(null_pos);
+    }
+
+    read_index_ += N;
+    return true;
+  }
+
+  template<bytepack::StringMode Mode>
+  bool read(std::string& value) noexcept
+  {
+    if constexpr (Mode == bytepack::StringMode::NullTerm) {
+      std::size_t end_index = read_index_;
+      // Find null terminator in the buffer starting from the current deserialize index
+      while (end_index < capacity_ && buffer_.as<char>()[end_index] != '\0') {
+        ++end_index; // Move to next byte
+      }
+
+      if (end_index >= capacity_) {
+        return fail(error_code::missing_terminator, read_index_); // Null terminator not found
+      }
+
+      const std::size_t str_length = end_index - read_index_;
+      trace_bulk_copy(false, read_index_, str_length);
+      value.assign(buffer_.as<char>() + read_index_, str_length);
+
+      read_index_ += str_length + 1; // +1 for null terminator
+    } else {
+      return read(value);
+    }
+
+    return true;
+  }
+
+  template<NetworkSerializableOptional OptionalType>
+  bool read(OptionalType& value) noexcept
+  {
+    std::uint8_t has_value{};
+    if (read(has_value) == false) {
+      return false;
+    }
+    if (has_value > 1) {
+      return fail(error_code::invalid_value, read_index_ - sizeof(has_value));
+    }
+
+    if (has_value == 0) {
+      value.reset();
+      return true;
+    }
+
+    // Construct the value in place, or reuse the existing one (keeps the capacity of strings/vectors)
+    if (value.has_value() == false) {
+      value.emplace();
+    }
+    return read(*value);
+  }
+
+  /**
+   * @brief Deserializes a variant. The alternative is selected with a compile-time generated table indexed by the tag
+   * and constructed in place in the variant (the held alternative is reused if the tag matches).
+   *
+   * @tparam TagType Type of the tag field. Defaults to std::uint8_t.
+   */
+  template<IntegralType TagType = std::uint8_t, typename... Ts>
+  requires NetworkSerializableVariant<std::variant<Ts...>>
+  bool read(std::variant<Ts...>& value) noexcept
+  {
+    TagType tag{};
+    if (read(tag) == false) {
+      return false;
+    }
+    if (tag < 0 || static_cast<std::size_t>(tag) >= sizeof...(Ts)) {
+      return fail(error_code::invalid_value, read_index_ - sizeof(TagType));
+    }
+
+    return read_alternative(value, static_cast<std::size_t>(tag), std::index_sequence_for<Ts...>{});
+  }
+
+  /**
+   * @brief Deserializes std::deque, std::list, std::map, std::unordered_map and sorted vectors of key-value pairs.
+   *
+   * - std::unordered_map reserves buckets for all entries up front.
+   * - std::map inserts with end hint, which is constant time when the serialized entries are sorted (as serialized
+   *   from std::map or a sorted vector).
+   * - std::deque, std::list and vectors of pairs are resized once and elements are deserialized in place. Vectors of
+   *   pairs are the contiguous alternative; their keys must be strictly increasing.
+   *
+   * Maps with duplicate keys and vectors of pairs with unsorted keys are rejected.
+   *
+   * @tparam SizeType Type of the element count field. Defaults to std::uint32_t.
+   */
+  template<IntegralType SizeType = std::uint32_t, NetworkSerializableContainer ContainerType>
+  bool read(ContainerType& container) noexcept
+  {
+    SizeType size_custom{};
+    if (read(size_custom) == false) {
+      return false;
+    }
+    const auto size = static_cast<std::size_t>(size_custom);
+
+    // Each element takes at least one byte. This prevents huge allocations caused by corrupted size fields.
+    if (size_custom < 0 || capacity_ - read_index_ < size) {
+      return fail(error_code::invalid_size, read_index_ - sizeof(SizeType));
+    }
+
+    if constexpr (NetworkSerializableMap<ContainerType>) {
+      container.clear();
+      if constexpr (requires { container.reserve(size); }) {
+        container.reserve(size);
+      }
+
+      for (std::size_t i = 0; i < size; ++i) {
+        typename ContainerType::key_type key{};
+        typename ContainerType::mapped_type mapped{};
+        if (read(key) == false || read(mapped) == false) {
+          return false;
+        }
+
+        const std::size_t previous_size = container.size();
+        if constexpr (requires { container.reserve(size); }) {
+          container.emplace(std::move(key), std::move(mapped));
+        } else {
+          container.emplace_hint(container.end(), std::move(key), std::move(mapped));
+        }
+
+        if (container.size() == previous_size) {
+          return fail(error_code::invalid_value, read_index_); // duplicate key
+        }
+      }
+    } else if constexpr (NetworkSerializableFlatMap<ContainerType>) {
+      container.resize(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        const std::size_t entry_index = read_index_;
+        if (read(container[i].first) == false || read(container[i].second) == false) {
+          return false;
+        }
+        if (i > 0 && !(container[i - 1].first < container[i].first)) {
+          return fail(error_code::invalid_value, entry_index); // unsorted or duplicate key
+        }
+      }
+    } else {
+      container.resize(size);
+      for (auto& element : container) {
+        if (read(element) == false) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Deserializes `std::vector<std::vector<T>>` / `std::vector<std::string>` formatted data into a flat_vector.
+   *
+   * All lengths are validated in a first pass, then all inner arrays are copied into a single backing buffer (two
+   * allocations in total, none if the flat_vector already has enough capacity).
+   *
+   * @tparam SizeType Type of the array count field. Defaults to std::uint32_t.
+   * @tparam InnerSizeType Type of the length field of each inner array. Defaults to std::uint32_t.
+   */
+  template<IntegralType SizeType = std::uint32_t, IntegralType InnerSizeType = std::uint32_t, typename T>
+  bool read(flat_vector<T>& value) noexcept
+  {
+    SizeType size_custom{};
+    const std::size_t start_index = read_index_;
+    if (read(size_custom) == false) {
+      return false;
+    }
+    if (size_custom < 0) {
+      return fail(error_code::invalid_size, start_index);
+    }
+    const auto count = static_cast<std::size_t>(size_custom);
+
+    // First pass: validate the lengths and calculate the total number of elements
+    std::size_t index = read_index_;
+    std::size_t total_elements = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      InnerSizeType inner_size{};
+      if (capacity_ - index < sizeof(InnerSizeType)) {
+        read_index_ = start_index;
+        return fail(error_code::buffer_overflow, index);
+      }
+      load_elements(index, &inner_size, 1);
+      index += sizeof(InnerSizeType);
+
+      if (inner_size < 0) {
+        read_index_ = start_index;
+        return fail(error_code::invalid_size, index - sizeof(InnerSizeType));
+      }
+      if ((capacity_ - index) / sizeof(T) < static_cast<std::size_t>(inner_size)) {
+        read_index_ = start_index;
+        return fail(error_code::buffer_overflow, index - sizeof(InnerSizeType));
+      }
+      index += static_cast<std::size_t>(inner_size) * sizeof(T);
+      total_elements += static_cast<std::size_t>(inner_size);
+    }
+
+    // Second pass: copy the inner arrays into the backing buffer
+    value.data_.resize(total_elements);
+    value.offsets_.resize(count + 1);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      InnerSizeType inner_size{};
+      load_elements(read_index_, &inner_size, 1);
+      read_index_ += sizeof(InnerSizeType);
+
+      const auto inner_count = static_cast<std::size_t>(inner_size);
+      load_elements(read_index_, value.data_.data() + offset, inner_count);
+      read_index_ += inner_count * sizeof(T);
+      offset += inner_count;
+      value.offsets_[i + 1] = offset;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Deserializes a floating-point value with the given encoding (e.g. float16, bfloat16, fixed_point).
+   */
+  template<FloatEncoding Encoding, std::floating_point T>
+  bool read(T& value) noexcept
+  {
+    return read_encoded<Encoding>(&value, 1);
+  }
+
+  template<FloatEncoding Encoding, std::floating_point T, std::size_t N>
+  bool read(T (&array)[N]) noexcept
+  {
+    return read_encoded<Encoding>(array, N);
+  }
+
+  template<FloatEncoding Encoding, std::floating_point T, std::size_t N>
+  bool read(std::array<T, N>& array) noexcept
+  {
+    return read_encoded<Encoding>(array.data(), N);
+  }
+
+  template<FloatEncoding Encoding, IntegralType SizeType = std::uint32_t, std::floating_point T>
+  bool read(std::vector<T>& vector) noexcept
+  {
+    SizeType size_custom{};
+    if (read(size_custom) == false) {
+      return false;
+    }
+    if (size_custom < 0) {
+      return fail(error_code::invalid_size, read_index_ - sizeof(SizeType));
+    }
+
+    const auto size = static_cast<std::size_t>(size_custom);
+    if (capacity_ < (read_index_ + size * sizeof(typename Encoding::wire_type))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    vector.resize(size);
+    return read_encoded<Encoding>(vector.data(), size);
+  }
+
+  /**
+   * @brief Deserializes an integer array encoded with frame-of-reference + bit-packing (see bit_packed).
+   */
+  template<std::same_as<bit_packed> Encoding, BitPackableInteger T, std::size_t N>
+  bool read(T (&array)[N]) noexcept
+  {
+    return read_bit_packed(array, N);
+  }
+
+  template<std::same_as<bit_packed> Encoding, BitPackableInteger T, std::size_t N>
+  bool read(std::array<T, N>& array) noexcept
+  {
+    return read_bit_packed(array.data(), N);
+  }
+
+  template<std::same_as<bit_packed> Encoding, IntegralType SizeType = std::uint32_t, BitPackableInteger T>
+  bool read(std::vector<T>& vector) noexcept
+  {
+    SizeType size_custom{};
+    if (read(size_custom) == false) {
+      return false;
+    }
+    if (size_custom < 0) {
+      return fail(error_code::invalid_size, read_index_ - sizeof(SizeType));
+    }
+
+    // Each block has at least a base and a bit width
+    const auto size = static_cast<std::size_t>(size_custom);
+    const std::size_t blocks = (size + bit_packed::block_size<T> - 1) / bit_packed::block_size<T>;
+    if (capacity_ < (read_index_ + blocks * (sizeof(T) + 1))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    vector.resize(size);
+    return read_bit_packed(vector.data(), size);
+  }
+
+  template<NetworkSerializableOptional... OptionalTypes>
+  bool read_optionals(OptionalTypes&... values) noexcept
+  {
+    constexpr std::size_t count = sizeof...(OptionalTypes);
+    std::array<std::uint8_t, (count + 7) / 8> presence{};
+    if (read(presence) == false) {
+      return false;
+    }
+    if (count % 8 != 0 && (presence.back() >> (count % 8)) != 0) {
+      return fail(error_code::invalid_value, read_index_ - presence.size());
+    }
+
+    std::size_t bit = 0;
+    const auto read_one = [&](auto& value) {
+      const bool has_value = (presence[bit / 8] >> (bit % 8)) & 1U;
+      ++bit;
+      if (has_value == false) {
+        value.reset();
+        return true;
+      }
+      if (value.has_value() == false) {
+        value.emplace();
+      }
+      return read(*value);
+    };
+    return (... && read_one(values));
+  }
 
   template<NetworkSerializableType FirstArg, NetworkSerializableType... Args>
-  bool write(const FirstArg& firstArg, const Args&... args) noexcept
+  bool read(FirstArg& firstArg, Args&... args) noexcept
+  {
+    return read(firstArg) && (... && read(args));
+  }
+
+  /**
+   * @brief Writes a single fixed-size field at the given byte offset from the beginning of the buffer.
+   *
+   * Used to patch one field of an already serialized message without serializing the entire object.
+   * It does not change the read/write positions of the stream.
+   *
+   * @tparam ByteOffset Byte offset of the field in the buffer.
+   */
+  template<std::size_t ByteOffset, NetworkSerializableFixedSize T>
+  bool write_field(const T& value) noexcept
+  {
+    if (buffer_.size() < (ByteOffset + wire_size_v<T>)) {
+      return false;
+    }
+
+    store_field(ByteOffset, value);
+    return true;
+  }
+
+  /**
+   * @brief Writes a single field by its index in the given field_layout. The byte offset is resolved at compile time.
+   */
+  template<FieldLayout Layout, std::size_t Index>
+  bool write_field(const typename Layout::template field_type<Index>& value) noexcept
+  {
+    return write_field<Layout::template offset<Index>>(value);
+  }
+
+  /**
+   * @brief Reads a single fixed-size field at the given byte offset from the beginning of the buffer.
+   *
+   * Used to extract one field of a serialized message without deserializing the entire object.
+   * It does not change the read/write positions of the stream.
+   *
+   * @tparam ByteOffset Byte offset of the field in the buffer.
+   */
+  template<std::size_t ByteOffset, NetworkSerializableFixedSize T>
+  bool read_field(T& value) const noexcept
+  {
+    if (buffer_.size() < (ByteOffset + wire_size_v<T>)) {
+      return false;
+    }
+
+    load_field(ByteOffset, value);
+    return true;
+  }
+
+  /**
+   * @brief Reads a single field by its index in the given field_layout. The byte offset is resolved at compile time.
+   */
+  template<FieldLayout Layout, std::size_t Index>
+  bool read_field(typename Layout::template field_type<Index>& value) const noexcept
+  {
+    return read_field<Layout::template offset<Index>>(value);
+  }
+
+  /**
+   * @brief Writes a single fixed-size field at a byte offset given at runtime (e.g. recorded during serialization).
+   * It does not change the read/write positions of the stream.
+   */
+  template<NetworkSerializableFixedSize T>
+  bool write_field(const T& value, const std::size_t byte_offset) noexcept
+  {
+    if (buffer_.size() < byte_offset || buffer_.size() - byte_offset < wire_size_v<T>) {
+      return false;
+    }
+
+    store_field(byte_offset, value);
+    return true;
+  }
+
+  /**
+   * @brief Reads a single fixed-size field at a byte offset given at runtime.
+   * It does not change the read/write positions of the stream.
+   */
+  template<NetworkSerializableFixedSize T>
+  bool read_field(T& value, const std::size_t byte_offset) const noexcept
+  {
+    if (buffer_.size() < byte_offset || buffer_.size() - byte_offset < wire_size_v<T>) {
+      return false;
+    }
+
+    load_field(byte_offset, value);
+    return true;
+  }
+
+private:
+  template<typename T>
+  bool write_alternative_value(const T& value) noexcept
+  {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+      return true; // empty alternative has no data
+    } else {
+      return write(value);
+    }
+  }
+
+  template<typename T>
+  bool read_alternative_value(T& value) noexcept
+  {
+    if constexpr (std::is_same_v<T, std::monostate>) {
+      return true;
+    } else {
+      return read(value);
+    }
+  }
+
+  template<typename Variant, std::size_t... Is>
+  bool write_alternative(const Variant& value, std::index_sequence<Is...>) noexcept
+  {
+    using writer = bool (*)(binary_stream&, const Variant&) noexcept;
+    static constexpr writer writers[] = { [](binary_stream& stream, const Variant& variant) noexcept {
+      return stream.write_alternative_value(*std::get_if<Is>(&variant));
+    }... };
+
+    return writers[value.index()](*this, value);
+  }
+
+  template<typename Variant, std::size_t... Is>
+  bool read_alternative(Variant& value, const std::size_t index, std::index_sequence<Is...>) noexcept
+  {
+    using reader = bool (*)(binary_stream&, Variant&) noexcept;
+    static constexpr reader readers[] = { [](binary_stream& stream, Variant& variant) noexcept {
+      if (variant.index() != Is) {
+        variant.template emplace<Is>();
+      }
+      return stream.read_alternative_value(*std::get_if<Is>(&variant));
+    }... };
+
+    return readers[index](*this, value);
+  }
+
+  // Encodes all values after a single bounds check
+  template<FloatEncoding Encoding, std::floating_point T>
+  bool write_encoded(const T* values, const std::size_t count) noexcept
+  {
+    using W = typename Encoding::wire_type;
+    if (capacity_ < (write_index_ + count * sizeof(W))) {
+      return fail(error_code::buffer_overflow, write_index_);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const W wire = Encoding::encode(values[i]);
+      store_elements(write_index_ + i * sizeof(W), &wire, 1);
+    }
+    write_index_ += count * sizeof(W);
+    return true;
+  }
+
+  template<FloatEncoding Encoding, std::floating_point T>
+  bool read_encoded(T* values, const std::size_t count) noexcept
+  {
+    using W = typename Encoding::wire_type;
+    if (capacity_ < (read_index_ + count * sizeof(W))) {
+      return fail(error_code::buffer_overflow, read_index_);
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      W wire{};
+      load_elements(read_index_ + i * sizeof(W), &wire, 1);
+      values[i] = Encoding::template decode<T>(wire);
+    }
+    read_index_ += count * sizeof(W);
+    return true;
+  }
+
+  // Frame-of-reference + bit-packing of blocks (see bit_packed). The write position is restored if a block does not
+  // fit.
+  template<BitPackableInteger T>
+  bool write_bit_packed(const T* values, const std::size_t count) noexcept
+  {
+    using U = std::make_unsigned_t<T>;
+    using Word = bit_packed::word_type<T>;
+    constexpr std::size_t block_size = bit_packed::block_size<T>;
+
+    const std::size_t start_index = write_index_;
+    Word deltas[block_size];
+    Word packed[block_size];
+    for (std::size_t first = 0; first < count; first += block_size) {
+      const std::size_t n = std::min(block_size, count - first);
+      const T* block = values + first;
+      const T base = *std::min_element(block, block + n);
+      Word bits{ 0 };
+      for (std::size_t i = 0; i < n; ++i) {
+        deltas[i] = static_cast<Word>(static_cast<U>(static_cast<U>(block[i]) - static_cast<U>(base)));
+        bits |= deltas[i];
+      }
+      const auto width = static_cast<std::uint8_t>(std::bit_width(bits));
+      const std::size_t size = n == block_size ? 4 * width * sizeof(Word) : (n * width + 7) / 8;
+
+      if (capacity_ < (write_index_ + sizeof(T) + sizeof(width) + size)) {
+        write_index_ = start_index;
+        return fail(error_code::buffer_overflow, start_index);
+      }
+      store_elements(write_index_, &base, 1);
+      store_elements(write_index_ + sizeof(T), &width, 1);
+      write_index_ += sizeof(T) + sizeof(width);
+
+      if (n == block_size) {
+        detail::pack_kernels<T>[width](deltas, packed);
+        store_elements(write_index_, packed, 4 * width);
+      } else {
+        std::memset(buffer_.as<std::uint8_t>() + write_index_, 0, size);
+        detail::pack_bits(deltas, n, width, buffer_.as<std::uint8_t>() + write_index_);
+      }
+      write_index_ += size;
+    }
+    return true;
+  }
+
+  template<BitPackableInteger T>
+  bool read_bit_packed(T* values, const std::size_t count) noexcept
+  {
+    using U = std::make_unsigned_t<T>;
+    using Word = bit_packed::word_type<T>;
+    constexpr std::size_t block_size = bit_packed::block_size<T>;
+
+    const std::size_t start_index = read_index_;
+    Word deltas[block_size];
+    Word packed[block_size];
+    for (std::size_t first = 0; first < count; first += block_size) {
+      const std::size_t n = std::min(block_size, count - first);
+      if (capacity_ < (read_index_ + sizeof(T) + 1)) {
+        read_index_ = start_index;
+        return fail(error_code::buffer_overflow, start_index);
+      }
+      T base{};
+      std::uint8_t width{};
+      load_elements(read_index_, &base, 1);
+      load_elements(read_index_ + sizeof(T), &width, 1);
+      if (width > 8 * sizeof(T)) {
+        read_index_ = start_index;
+        return fail(error_code::invalid_value, start_index);
+      }
+      read_index_ += sizeof(T) + 1;
+
+      const std::size_t size = n == block_size ? 4 * std::size_t{ width } * sizeof(Word) : (n * width + 7) / 8;
+      if (capacity_ < (read_index_ + size)) {
+        read_index_ = start_index;
+        return fail(error_code::buffer_overflow, start_index);
+      }
+      if (n == block_size) {
+        load_elements(read_index_, packed, 4 * std::size_t{ width });
+        detail::unpack_kernels<T>[width](packed, deltas);
+      } else {
+        detail::unpack_bits(buffer_.as<const std::uint8_t>() + read_index_, n, width, deltas);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        values[first + i] = static_cast<T>(static_cast<U>(static_cast<U>(base) + static_cast<U>(deltas[i])));
+      }
+      read_index_ += size;
+    }
+    return true;
+  }
+
+  // Bulk copy of array, vector and string data at the current write/read position (bounds are checked by the caller)
+  template<typename T>
+  void write_elements(const T* elements, const std::size_t count) noexcept
   {
-    return write(firstArg) && (... && write(args));
+    trace_bulk_copy(true, write_index_, count * sizeof(T));
+    store_elements(write_index_, elements, count);
+    write_index_ += count * sizeof(T);
   }
 
-  // TODO: Currently, the serialization of std::wstring and std::wstring_view is not supported
-  // due to the variation in wchar_t size across platforms (e.g., 2 bytes on Windows, 4 bytes on Unix/Linux).
-  // A future enhancement could involve standardizing on a character encoding like UTF-8 for network
-  // transmission and handling the conversion from/to std::wstring while considering platform differences.
-  // This would ensure consistent behavior across different systems and avoid issues with wchar_t size discrepancies.
-  // For now, users can use std::string and std::string_view for string serialization.
+  template<typename T>
+  void read_elements(T* elements, const std::size_t count) noexcept
+  {
+    trace_bulk_copy(false, read_index_, count * sizeof(T));
+    load_elements(read_index_, elements, count);
+    read_index_ += count * sizeof(T);
+  }
 
-  template<NetworkSerializableBasic T>
-  bool read(T& value) noexcept
+  // Single copy of wire-compatible structs (layout and endianness are checked by the caller)
+  template<WireStruct T>
+  void write_wire_structs(const T* values, const std::size_t count) noexcept
   {
-    if (buffer_.size() < (read_index_ + sizeof(T))) {
-      return false;
-    }
+    static_assert(ReadOnly == false && sizeof(T) > 0, "binary_reader is read-only");
+    trace_bulk_copy(true, write_index_, count * sizeof(T));
+    std::memcpy(buffer_.as<std::uint8_t>() + write_index_, values, count * sizeof(T));
+    write_index_ += count * sizeof(T);
+  }
 
-    std::memcpy(&value, buffer_.as<std::uint8_t>() + read_index_, sizeof(T));
+  template<WireStruct T>
+  void read_wire_structs(T* values, const std::size_t count) noexcept
+  {
+    trace_bulk_copy(false, read_index_, count * sizeof(T));
+    std::memcpy(values, buffer_.as<const std::uint8_t>() + read_index_, count * sizeof(T));
+    read_index_ += count * sizeof(T);
+  }
 
-    if constexpr (BufferEndian != std::endian::native && sizeof(T) > 1) {
-      // Using reinterpret_cast to treat 'value' as an array of bytes is safe here because:
-      // The `NetworkSerializableBasic` concept ensures 'T' is a non-class, fundamental type, making
-      // it trivially copyable and ensuring a consistent, predictable memory layout across systems.
-      std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&value),
-                           reinterpret_cast<std::uint8_t*>(&value) + sizeof(T));
-    }
+  // Copies the elements to the buffer at the given byte index with endianness conversion (no bounds check)
+  template<NetworkSerializableBasic T>
+  void store_elements(const std::size_t index, const T* elements, const std::size_t count) noexcept
+  {
+    static_assert(ReadOnly == false && sizeof(T) > 0, "binary_reader is read-only");
+    detail::store_elements<BufferEndian>(buffer_.as<std::uint8_t>() + index, elements, count);
+  }
 
-    read_index_ += sizeof(T);
+  // Copies the elements from the buffer at the given byte index with endianness conversion (no bounds check)
+  template<NetworkSerializableBasic T>
+  void load_elements(const std::size_t index, T* elements, const std::size_t count) const noexcept
+  {
+    detail::load_elements<BufferEndian>(buffer_.as<std::uint8_t>() + index, elements, count);
+  }
 
-    return true;
+  template<NetworkSerializableFixedSize T>
+  void store_field(const std::size_t index, const T& value) noexcept
+  {
+    static_assert(ReadOnly == false && sizeof(T) > 0, "binary_reader is read-only");
+    detail::store_field<BufferEndian>(buffer_.as<std::uint8_t>() + index, value);
   }
 
-  template<NetworkSerializableBasicArray T>
-  bool read(T& value) noexcept
+  template<NetworkSerializableFixedSize T>
+  void load_field(const std::size_t index, T& value) const noexcept
   {
-    using ElementType = std::remove_extent_t<T>;
-    constexpr std::size_t elementSize = sizeof(ElementType);
-    constexpr std::size_t numElements = sizeof(T) / elementSize;
+    detail::load_field<BufferEndian>(buffer_.as<std::uint8_t>() + index, value);
+  }
 
-    // Check if there is enough data in the buffer to read the entire array
-    if (buffer_.size() < (read_index_ + sizeof(T))) {
-      return false;
+  constexpr void begin_cycle() noexcept
+  {
+    if constexpr (Instrumentation::enabled) {
+      Instrumentation::on_begin(instrumentation_state_, buffer_.size());
     }
+  }
 
-    if constexpr (BufferEndian == std::endian::native || elementSize == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(value, buffer_.as<std::uint8_t>() + read_index_, sizeof(T));
-      read_index_ += sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (size_t i = 0; i < numElements; ++i) {
-        std::memcpy(&value[i], buffer_.as<std::uint8_t>() + read_index_, elementSize);
-        std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&value[i]),
-                             reinterpret_cast<std::uint8_t*>(&value[i]) + elementSize);
-        read_index_ += elementSize;
-      }
+  constexpr void record_cycle() noexcept
+  {
+    if constexpr (Instrumentation::enabled) {
+      Instrumentation::on_end(instrumentation_state_, write_index_, read_index_, buffer_.size());
+      instrumentation_state_ = typename Instrumentation::stream_state{};
     }
-
-    return true;
   }
 
-  template<typename T, std::size_t N>
-  requires NetworkSerializableBasic<T>
-  bool read(std::array<T, N>& array) noexcept
+  constexpr void trace_bulk_copy([[maybe_unused]] const bool is_write, [[maybe_unused]] const std::size_t offset,
+                                 [[maybe_unused]] const std::size_t size) const noexcept
   {
-    // Check if there is enough data in the buffer to read the entire array
-    if (buffer_.size() < (read_index_ + N * sizeof(T))) {
-      return false;
+    if constexpr (Instrumentation::enabled) {
+      Instrumentation::on_bulk_copy(is_write, offset, size);
     }
+  }
 
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(array.data(), buffer_.as<std::uint8_t>() + read_index_, N * sizeof(T));
-      read_index_ += N * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (size_t i = 0; i < N; ++i) {
-        std::memcpy(&array[i], buffer_.as<std::uint8_t>() + read_index_, sizeof(T));
-        std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&array[i]),
-                             reinterpret_cast<std::uint8_t*>(&array[i]) + sizeof(T));
-        read_index_ += sizeof(T);
+  // Records the first error. In sticky mode, the usable capacity is set to zero so that all later sequential
+  // reads/writes fail in their existing bounds checks, without an additional branch in the success path.
+  constexpr bool fail(const error_code code, const std::size_t offset,
+                      [[maybe_unused]] const std::source_location location = std::source_location::current()) noexcept
+  {
+    if constexpr (Instrumentation::enabled) {
+      Instrumentation::on_failure(code, offset, location);
+    }
+    if (error_.code == error_code::success) {
+      error_ = stream_error{ code, offset };
+      if (error_mode_ == ErrorMode::Sticky) {
+        capacity_ = 0;
       }
     }
-
-    return true;
+    return false;
   }
 
-  template<IntegralType SizeType = std::uint32_t, typename T>
-  requires NetworkSerializableBasic<T>
-  bool read(std::vector<T>& vector) noexcept
-  {
-    SizeType size_custom{};
-    // vector size cannot be negative, so it's treated as an error. Zero size is well-defined for dynamic containers if
-    // they are not serialized with a given fixed size because it indicates an empty container.
-    if (read(size_custom) == false || size_custom < 0) {
-      return false;
-    }
-    const auto size = static_cast<std::size_t>(size_custom);
+  bytepack::buffer_view buffer_;
 
-    if (buffer_.size() < (read_index_ + size * sizeof(T))) {
-      return false;
-    }
+  // Flag to indicate buffer ownership
+  // TODO: Consider alternative ownership models, and design to handle external buffers
+  bool owns_buffer_;
 
-    vector.resize(size);
+  std::size_t write_index_;
+  std::size_t read_index_;
 
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(vector.data(), buffer_.as<std::uint8_t>() + read_index_, size * sizeof(T));
-      read_index_ += size * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < size; ++i) {
-        std::memcpy(&vector[i], buffer_.as<std::uint8_t>() + read_index_, sizeof(T));
-        std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&vector[i]),
-                             reinterpret_cast<std::uint8_t*>(&vector[i]) + sizeof(T));
-        read_index_ += sizeof(T);
-      }
+  // Usable buffer size for sequential reads/writes (zero after an error in sticky mode)
+  std::size_t capacity_;
+  ErrorMode error_mode_;
+  stream_error error_{};
+
+  [[no_unique_address]] typename Instrumentation::stream_state instrumentation_state_{};
+};
+
+/**
+ * @brief Read-only binary_stream over immutable memory (`const_buffer_view`). It has the whole read API of
+ * binary_stream; any call to a write method fails to compile. Readers over the same const data can be used from
+ * multiple threads, since the data is never modified (each reader has its own read position).
+ *
+ *   const std::uint8_t packet[]{ 0x00, 0x2A, 0x01 };
+ *   bytepack::binary_reader reader(bytepack::const_buffer_view(packet));
+ *   reader.read(value, flag);
+ */
+template<std::endian BufferEndian = std::endian::big, StreamInstrumentation Instrumentation = no_instrumentation>
+using binary_reader = binary_stream<BufferEndian, Instrumentation, true>;
+
+/**
+ * @struct field_slot
+ * @brief Typed handle to a fixed-size field of a message_template, holding its byte offset in the serialized data.
+ */
+template<NetworkSerializableFixedSize T>
+struct field_slot
+{
+  using value_type = T;
+
+  std::size_t offset{ 0 };
+};
+
+/**
+ * @class message_template
+ * @brief A pre-serialized message whose mutable ("hot") fields are patched in place before each send.
+ *
+ * Structurally identical messages (e.g. periodic telemetry) are serialized once through `stream()`. Mutable fields are
+ * written with `write_mutable()`, which records their byte offsets in `field_slot`s. For each send, only these fields
+ * are patched (with endianness conversion), optionally followed by a checksum update, instead of serializing every
+ * field again.
+ *
+ * @tparam BufferEndian The endianness to use for serialization. Defaults to big-endian (network byte order).
+ */
+template<std::endian BufferEndian = std::endian::big>
+class message_template final
+{
+public:
+  explicit message_template(const std::size_t buffer_size) noexcept : stream_{ buffer_size } {}
+
+  explicit message_template(const bytepack::buffer_view& buffer) noexcept : stream_{ buffer } {}
+
+  /**
+   * @brief Stream used to serialize the constant part of the message (in order with the mutable fields).
+   */
+  [[nodiscard]] binary_stream<BufferEndian>& stream() noexcept { return stream_; }
+
+  /**
+   * @brief Serializes a mutable field with its initial value and records its byte offset in the given slot.
+   */
+  template<NetworkSerializableFixedSize T>
+  bool write_mutable(field_slot<T>& slot, const T& initial_value = T{}) noexcept
+  {
+    const std::size_t offset = stream_.data().size();
+    if (stream_.write(initial_value) == false) {
+      return false;
     }
+
+    slot.offset = offset;
     return true;
   }
 
-  template<std::size_t N, typename T>
-  requires NetworkSerializableBasic<T>
-  bool read(std::vector<T>& vector) noexcept
+  /**
+   * @brief Patches a mutable field of the serialized template in place.
+   */
+  template<NetworkSerializableFixedSize T>
+  bool patch(const field_slot<T>& slot, const T& value) noexcept
+  {
+    return stream_.write_field(value, slot.offset);
+  }
+
+  /**
+   * @brief Recomputes the checksum field from the bytes in range [begin_offset, slot.offset) of the template.
+   *
+   * @param checksum_fn Callable as `checksum_fn(const std::uint8_t* data, std::size_t size)` returning the checksum
+   *                    value (e.g. CRC32). It is called on the serialized (wire) bytes.
+   */
+  template<IntegralType C, typename ChecksumFn>
+  requires std::is_invocable_r_v<C, ChecksumFn, const std::uint8_t*, std::size_t>
+  bool update_checksum(const field_slot<C>& slot, ChecksumFn&& checksum_fn, const std::size_t begin_offset = 0) noexcept
   {
-    if (buffer_.size() < (read_index_ + N * sizeof(T))) {
+    const bytepack::buffer_view serialized = stream_.data();
+    if (begin_offset > slot.offset || slot.offset > serialized.size()) {
       return false;
     }
 
-    vector.resize(N);
-
-    if constexpr (BufferEndian == std::endian::native || sizeof(T) == 1) {
-      // If the buffer and system endianness match, or each element is one byte,
-      // endianness is irrelevant, so memcpy the entire array at once
-      std::memcpy(vector.data(), buffer_.as<std::uint8_t>() + read_index_, N * sizeof(T));
-      read_index_ += N * sizeof(T);
-    } else {
-      // For multibyte types with differing endianness, handle each element individually
-      for (std::size_t i = 0; i < N; ++i) {
-        std::memcpy(&vector[i], buffer_.as<std::uint8_t>() + read_index_, sizeof(T));
-        std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&vector[i]),
-                             reinterpret_cast<std::uint8_t*>(&vector[i]) + sizeof(T));
-        read_index_ += sizeof(T);
-      }
-    }
-    return true;
+    const C checksum = checksum_fn(serialized.as<std::uint8_t>() + begin_offset, slot.offset - begin_offset);
+    return stream_.write_field(checksum, slot.offset);
   }
 
-  template<IntegralType SizeType = std::uint32_t>
-  bool read(std::string& value) noexcept
+  /**
+   * @brief Copies the serialized template into the target buffer (e.g. a per-send buffer). Field slots are also valid
+   * for the copy, so it can be patched with `binary_stream::write_field(value, slot.offset)`.
+   */
+  bool copy_to(const bytepack::buffer_view& target) const noexcept
   {
-    if (buffer_.size() < (read_index_ + sizeof(SizeType))) {
+    const bytepack::buffer_view serialized = stream_.data();
+    if (target.size() < serialized.size()) {
       return false;
     }
 
-    // Temporarily read string length without incrementing deserialize index
-    SizeType str_length{};
-    std::memcpy(&str_length, buffer_.as<std::uint8_t>() + read_index_, sizeof(SizeType));
+    std::memcpy(target.as<std::uint8_t>(), serialized.as<std::uint8_t>(), serialized.size());
+    return true;
+  }
 
-    // Handle endianness for the string length
-    if constexpr (BufferEndian != std::endian::native && sizeof(SizeType) > 1) {
-      std::ranges::reverse(reinterpret_cast<std::uint8_t*>(&str_length),
-                           reinterpret_cast<std::uint8_t*>(&str_length) + sizeof(SizeType));
-    }
+  [[nodiscard]] bytepack::buffer_view data() const noexcept { return stream_.data(); }
 
-    // String length cannot be negative, so it's treated as an error. Zero length is well-defined for dynamic strings if
-    // they are not serialized with a given fixed length because it indicates an empty string.
-    if (str_length < 0) {
-      return false;
-    }
+private:
+  binary_stream<BufferEndian> stream_;
+};
 
-    if (buffer_.size() < (read_index_ + sizeof(SizeType) + static_cast<std::size_t>(str_length))) {
-      return false;
-    }
+/**
+ * @class message_view
+ * @brief Zero-copy typed accessor for a fixed-layout message in an existing buffer.
+ *
+ * Nothing is decoded up front: each getter/setter reads or writes a single field at its compile-time byte offset, with
+ * endianness conversion on access. For instance, a router can inspect the identifier of a received message without
+ * touching the other fields. The view does not own the buffer and is cheap to copy. Check `is_valid()` before using
+ * the value-returning getter on a buffer that may be shorter than the layout.
+ *
+ * @tparam Layout field_layout of the message.
+ * @tparam BufferEndian The endianness of the serialized data. Defaults to big-endian (network byte order).
+ * @tparam ReadOnly If true, the view is constructed over immutable memory (`const_buffer_view`) and has no setters.
+ *                  See `const_message_view`.
+ */
+template<FieldLayout Layout, std::endian BufferEndian = std::endian::big, bool ReadOnly = false>
+class message_view final
+{
+public:
+  using layout_type = Layout;
+  using buffer_type = std::conditional_t<ReadOnly, bytepack::const_buffer_view, bytepack::buffer_view>;
 
-    // Alternative approach in case of performance issues: first resize the string to the required size
-    // using `value.resize(str_length)` and then copy the string data using `std::memcpy(value.data(), ...)`
-    value.assign(buffer_.as<char>() + sizeof(SizeType) + read_index_, static_cast<std::size_t>(str_length));
+  explicit constexpr message_view(const bytepack::buffer_view& buffer) noexcept : buffer_{ buffer } {}
 
-    read_index_ += sizeof(SizeType) + static_cast<std::size_t>(str_length);
+  explicit constexpr message_view(const bytepack::const_buffer_view& buffer) noexcept
+  requires ReadOnly
+    : buffer_{ buffer }
+  {}
 
-    return true;
+  /**
+   * @brief Returns true if the buffer is large enough for all fields of the layout.
+   */
+  [[nodiscard]] constexpr bool is_valid() const noexcept { return buffer_.size() >= Layout::size; }
+
+  /**
+   * @brief Returns the value of the field at the given index. The field must be inside the buffer (asserted).
+   */
+  template<std::size_t Index>
+  requires(std::is_array_v<typename Layout::template field_type<Index>> == false)
+  [[nodiscard]] typename Layout::template field_type<Index> get() const noexcept
+  {
+    assert(contains<Index>() && "message_view: field exceeds the buffer");
+    typename Layout::template field_type<Index> value{};
+    detail::load_field<BufferEndian>(buffer_.template as<std::uint8_t>() + Layout::template offset<Index>, value);
+    return value;
   }
 
-  template<std::size_t N>
-  bool read(std::string& value) noexcept
+  /**
+   * @brief Reads the field at the given index. Returns false if the field exceeds the buffer.
+   */
+  template<std::size_t Index>
+  bool get(typename Layout::template field_type<Index>& value) const noexcept
   {
-    if (buffer_.size() < (read_index_ + N)) {
-      // Not enough data in the buffer to read the string
+    if (contains<Index>() == false) {
       return false;
     }
 
-    value.assign(buffer_.as<char>() + read_index_, N);
+    detail::load_field<BufferEndian>(buffer_.template as<std::uint8_t>() + Layout::template offset<Index>, value);
+    return true;
+  }
 
-    // TODO: This code uses `value.find('\0')` for a linear search to locate the first null character, suitable for
-    // shorter strings. For longer strings, especially when nulls are at the end, first checking the last character for
-    // null can optimize performance. If it's not null, we can avoid the search entirely. Otherwise, a binary
-    // search-like method is more efficient for such strings, as it exponentially narrows the search space, quickly
-    // finding the initial null character, thus enhancing performance for longer lengths.
-    if (const std::size_t null_pos = value.find('\0'); null_pos != std::string::npos) {
-      // If the string in the buffer is null-terminated, resize the string to the actual length
-      value.resize(null_pos);
+  /**
+   * @brief Writes the field at the given index in place. Returns false if the field exceeds the buffer.
+   */
+  template<std::size_t Index>
+  requires(ReadOnly == false)
+  bool set(const typename Layout::template field_type<Index>& value) noexcept
+  {
+    if (contains<Index>() == false) {
+      return false;
     }
 
-    read_index_ += N;
+    detail::store_field<BufferEndian>(buffer_.template as<std::uint8_t>() + Layout::template offset<Index>, value);
     return true;
   }
 
-  template<bytepack::StringMode Mode>
-  bool read(std::string& value) noexcept
+  [[nodiscard]] constexpr buffer_type data() const noexcept { return buffer_; }
+
+private:
+  // Indices out of the layout do not compile (field_type); the end of the field is a compile-time constant
+  template<std::size_t Index>
+  [[nodiscard]] constexpr bool contains() const noexcept
   {
-    if constexpr (Mode == bytepack::StringMode::NullTerm) {
-      std::size_t end_index = read_index_;
-      // Find null terminator in the buffer starting from the current deserialize index
-      while (end_index < buffer_.size() && buffer_.as<char>()[end_index] != '\0') {
-        ++end_index; // Move to next byte
-      }
+    using field_type = typename Layout::template field_type<Index>;
+    return buffer_.size() >= Layout::template offset<Index> + wire_size_v<field_type>;
+  }
 
-      if (end_index >= buffer_.size()) {
-        return false; // Null terminator not found
-      }
+  buffer_type buffer_;
+};
 
-      const std::size_t str_length = end_index - read_index_;
-      value.assign(buffer_.as<char>() + read_index_, str_length);
+/**
+ * @brief Read-only message_view over immutable memory, e.g. a `const` packet or a read-only memory mapping.
+ *
+ *   const bytepack::const_message_view<SensorLayout> view(bytepack::const_buffer_view(packet));
+ */
+template<FieldLayout Layout, std::endian BufferEndian = std::endian::big>
+using const_message_view = message_view<Layout, BufferEndian, true>;
 
-      read_index_ += str_length + 1; // +1 for null terminator
-    } else {
-      return read(value);
-    }
+/**
+ * @brief Selects the stream endianness at runtime, once per message. A `binary_stream` of the given endianness is
+ * created over the buffer and passed to the visitor, so the whole message is serialized/deserialized by the
+ * compile-time specialized stream without per-field endianness checks. Serialization functions are written once as
+ * templates on the stream endianness:
+ *
+ *   template<std::endian E> bool deserialize(bytepack::binary_stream<E>& stream) { return stream.read(a, b, c); }
+ *
+ *   const auto endian = (flags & 0x01) ? std::endian::little : std::endian::big; // e.g. from the message header
+ *   const bool ok = bytepack::dispatch_endian(endian, buffer, [&](auto& stream) { return msg.deserialize(stream); });
+ *
+ * @param endian `std::endian::little` or `std::endian::big` (any other value is treated as big-endian).
+ * @return The result of the visitor. The visitor must return the same type for both endiannesses.
+ */
+template<StreamInstrumentation Instrumentation = no_instrumentation, typename Visitor>
+requires std::invocable<Visitor&, binary_stream<std::endian::big, Instrumentation>&>
+         && std::invocable<Visitor&, binary_stream<std::endian::little, Instrumentation>&>
+         && std::same_as<std::invoke_result_t<Visitor&, binary_stream<std::endian::big, Instrumentation>&>,
+                         std::invoke_result_t<Visitor&, binary_stream<std::endian::little, Instrumentation>&>>
+decltype(auto) dispatch_endian(const std::endian endian, const bytepack::buffer_view& buffer, Visitor&& visitor,
+                               const ErrorMode error_mode = ErrorMode::Default)
+{
+  if (endian == std::endian::little) {
+    binary_stream<std::endian::little, Instrumentation> stream{ buffer, error_mode };
+    return visitor(stream);
+  }
+  binary_stream<std::endian::big, Instrumentation> stream{ buffer, error_mode };
+  return visitor(stream);
+}
 
-    return true;
+/**
+ * @brief Overload for immutable buffers (e.g. `const` packets, read-only mappings): the visitor receives a
+ * `binary_reader` of the selected endianness. The buffer type is checked first, so that visitors written for
+ * `binary_stream` are not instantiated with a reader when a mutable `buffer_view` is passed.
+ */
+template<StreamInstrumentation Instrumentation = no_instrumentation, std::same_as<const_buffer_view> ConstBuffer,
+         typename Visitor>
+requires std::invocable<Visitor&, binary_reader<std::endian::big, Instrumentation>&>
+         && std::invocable<Visitor&, binary_reader<std::endian::little, Instrumentation>&>
+         && std::same_as<std::invoke_result_t<Visitor&, binary_reader<std::endian::big, Instrumentation>&>,
+                         std::invoke_result_t<Visitor&, binary_reader<std::endian::little, Instrumentation>&>>
+decltype(auto) dispatch_endian(const std::endian endian, const ConstBuffer& buffer, Visitor&& visitor,
+                               const ErrorMode error_mode = ErrorMode::Default)
+{
+  if (endian == std::endian::little) {
+    binary_reader<std::endian::little, Instrumentation> stream{ buffer, error_mode };
+    return visitor(stream);
   }
+  binary_reader<std::endian::big, Instrumentation> stream{ buffer, error_mode };
+  return visitor(stream);
+}
 
-  template<NetworkSerializableType FirstArg, NetworkSerializableType... Args>
-  bool read(FirstArg& firstArg, Args&... args) noexcept
-  {
-    return read(firstArg) && (... && read(args));
+namespace detail {
+
+template<std::endian BufferEndian, NetworkSerializableBasic T, std::size_t N>
+constexpr void pack_element(std::array<std::uint8_t, N>& packet, std::size_t& index, const T& value) noexcept
+{
+  for (const std::uint8_t byte : to_buffer_bytes<BufferEndian>(value)) {
+    packet[index++] = byte;
   }
+}
 
-private:
-  bytepack::buffer_view buffer_;
+template<std::endian BufferEndian, NetworkSerializableBasic T>
+constexpr void unpack_element(const std::uint8_t* packet, std::size_t& index, T& value) noexcept
+{
+  std::array<std::uint8_t, sizeof(T)> bytes{};
+  for (std::uint8_t& byte : bytes) {
+    byte = packet[index++];
+  }
+  value = from_buffer_bytes<BufferEndian, T>(bytes);
+}
 
-  // Flag to indicate buffer ownership
-  // TODO: Consider alternative ownership models, and design to handle external buffers
-  bool owns_buffer_;
+template<std::endian BufferEndian, NetworkSerializableFixedSize T, std::size_t N>
+constexpr void pack_field(std::array<std::uint8_t, N>& packet, std::size_t& index, const T& value) noexcept
+{
+  if constexpr (NetworkSerializableBasic<T>) {
+    pack_element<BufferEndian>(packet, index, value);
+  } else {
+    for (const auto& element : value) {
+      pack_element<BufferEndian>(packet, index, element);
+    }
+  }
+}
 
-  std::size_t write_index_;
-  std::size_t read_index_;
-};
+template<std::endian BufferEndian, NetworkSerializableFixedSize T>
+constexpr void unpack_field(const std::uint8_t* packet, std::size_t& index, T& value) noexcept
+{
+  if constexpr (NetworkSerializableBasic<T>) {
+    unpack_element<BufferEndian>(packet, index, value);
+  } else {
+    for (auto& element : value) {
+      unpack_element<BufferEndian>(packet, index, element);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Serializes fixed-size values (basic types, C-style arrays and std::array) into a packet at compile time.
+ *
+ * The packet has the same format as `binary_stream<BufferEndian>::write(values...)`. Constant messages (e.g. protocol
+ * headers and control messages) can be precomputed as constexpr and sent without serialization at runtime:
+ *
+ *   constexpr auto heartbeat = bytepack::make_packet(std::uint8_t{ 0xA5 }, MessageType::Heartbeat, std::uint16_t{ 1 });
+ *   stream.write(heartbeat); // or send heartbeat.data() directly
+ *
+ * @tparam BufferEndian The endianness to use for serialization. Defaults to big-endian (network byte order).
+ */
+template<std::endian BufferEndian = std::endian::big, NetworkSerializableFixedSize... Ts>
+[[nodiscard]] constexpr std::array<std::uint8_t, (std::size_t{ 0 } + ... + wire_size_v<Ts>)>
+make_packet(const Ts&... values) noexcept
+{
+  std::array<std::uint8_t, (std::size_t{ 0 } + ... + wire_size_v<Ts>)> packet{};
+  std::size_t index = 0;
+  (detail::pack_field<BufferEndian>(packet, index, values), ...);
+  return packet;
+}
+
+/**
+ * @brief Deserializes fixed-size values from a packet (e.g. created by make_packet). It can be used at compile time.
+ *
+ * @return false if the packet is smaller than the values.
+ */
+template<std::endian BufferEndian = std::endian::big, std::size_t N, NetworkSerializableFixedSize... Ts>
+constexpr bool read_packet(const std::array<std::uint8_t, N>& packet, Ts&... values) noexcept
+{
+  if (N < (std::size_t{ 0 } + ... + wire_size_v<Ts>)) {
+    return false;
+  }
+
+  std::size_t index = 0;
+  (detail::unpack_field<BufferEndian>(packet.data(), index, values), ...);
+  return true;
+}
 
 } // namespace bytepack
 
@@ -0,0 +1,509 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file compression.hpp
+ * @brief Optional post-serialization stage: byte-shuffle/bit-shuffle filters and a small dependency-free LZ codec.
+ *
+ * Arrays of multibyte values (e.g. float sensor blocks) compress poorly as they are, because similar bytes (sign,
+ * exponent, etc.) are spread apart. Shuffle filters group the n-th bytes (or bits) of all elements together before
+ * compression, which exposes long runs to the LZ codec.
+ *
+ * Frame format of compression_stage (big-endian header):
+ * - filter (std::uint8_t) + element size (std::uint8_t) + uncompressed size (std::uint32_t) + LZ compressed data
+ *
+ * LZ compressed data is a sequence of: token (std::uint8_t, high nibble: literal length, low nibble: match length - 4,
+ * 15 means extra length bytes follow, each added until a byte other than 255) + literals + match offset
+ * (std::uint16_t, little-endian) + extra match length bytes. The last sequence has only literals.
+ */
+
+#ifndef BYTEPACK_COMPRESSION_HPP
+#define BYTEPACK_COMPRESSION_HPP
+
+#include <limits>
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+enum class shuffle_filter : std::uint8_t { none = 0, byte = 1, bit = 2 };
+
+namespace detail {
+
+// The shuffle kernels take the element size as a template argument, so that the strides of the instantiations for the
+// common sizes are constants. `ElementSize == 0` uses the size given at runtime.
+template<std::size_t ElementSize = 0>
+void byte_shuffle(const std::uint8_t* src, std::uint8_t* dest, const std::size_t size,
+                  const std::size_t runtime_element_size = ElementSize) noexcept
+{
+  const std::size_t element_size = ElementSize != 0 ? ElementSize : runtime_element_size;
+  const std::size_t count = size / element_size;
+  for (std::size_t j = 0; j < element_size; ++j) {
+    for (std::size_t i = 0; i < count; ++i) {
+      dest[j * count + i] = src[i * element_size + j];
+    }
+  }
+  // Trailing bytes that do not form a whole element are copied as they are
+  std::memcpy(dest + count * element_size, src + count * element_size, size - count * element_size);
+}
+
+template<std::size_t ElementSize = 0>
+void byte_unshuffle(const std::uint8_t* src, std::uint8_t* dest, const std::size_t size,
+                    const std::size_t runtime_element_size = ElementSize) noexcept
+{
+  const std::size_t element_size = ElementSize != 0 ? ElementSize : runtime_element_size;
+  const std::size_t count = size / element_size;
+  for (std::size_t i = 0; i < count; ++i) {
+    for (std::size_t j = 0; j < element_size; ++j) {
+      dest[i * element_size + j] = src[j * count + i];
+    }
+  }
+  std::memcpy(dest + count * element_size, src + count * element_size, size - count * element_size);
+}
+
+// Transposes an 8x8 bit matrix (row i is byte i): bit k of byte i becomes bit i of byte k
+constexpr std::uint64_t transpose_bits(std::uint64_t x) noexcept
+{
+  std::uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x = x ^ t ^ (t << 28);
+  return x;
+}
+
+// Bit planes are stored in order of (byte index in element, bit index in byte). Elements are processed in groups of 8;
+// the remaining elements and trailing bytes are copied as they are.
+template<std::size_t ElementSize = 0>
+void bit_shuffle(const std::uint8_t* src, std::uint8_t* dest, const std::size_t size,
+                 const std::size_t runtime_element_size = ElementSize) noexcept
+{
+  const std::size_t element_size = ElementSize != 0 ? ElementSize : runtime_element_size;
+  const std::size_t groups = size / element_size / 8;
+  for (std::size_t j = 0; j < element_size; ++j) {
+    for (std::size_t g = 0; g < groups; ++g) {
+      std::uint64_t x = 0;
+      for (std::size_t i = 0; i < 8; ++i) {
+        x |= static_cast<std::uint64_t>(src[(g * 8 + i) * element_size + j]) << (8 * i);
+      }
+      x = transpose_bits(x);
+      for (std::size_t k = 0; k < 8; ++k) {
+        dest[(j * 8 + k) * groups + g] = static_cast<std::uint8_t>(x >> (8 * k));
+      }
+    }
+  }
+  const std::size_t shuffled = groups * 8 * element_size;
+  std::memcpy(dest + shuffled, src + shuffled, size - shuffled);
+}
+
+template<std::size_t ElementSize = 0>
+void bit_unshuffle(const std::uint8_t* src, std::uint8_t* dest, const std::size_t size,
+                   const std::size_t runtime_element_size = ElementSize) noexcept
+{
+  const std::size_t element_size = ElementSize != 0 ? ElementSize : runtime_element_size;
+  const std::size_t groups = size / element_size / 8;
+  for (std::size_t j = 0; j < element_size; ++j) {
+    for (std::size_t g = 0; g < groups; ++g) {
+      std::uint64_t x = 0;
+      for (std::size_t k = 0; k < 8; ++k) {
+        x |= static_cast<std::uint64_t>(src[(j * 8 + k) * groups + g]) << (8 * k);
+      }
+      x = transpose_bits(x);
+      for (std::size_t i = 0; i < 8; ++i) {
+        dest[(g * 8 + i) * element_size + j] = static_cast<std::uint8_t>(x >> (8 * i));
+      }
+    }
+  }
+  const std::size_t shuffled = groups * 8 * element_size;
+  std::memcpy(dest + shuffled, src + shuffled, size - shuffled);
+}
+
+inline bytepack::buffer_view empty_view() noexcept
+{
+  return bytepack::buffer_view(static_cast<void*>(nullptr), 0);
+}
+
+} // namespace detail
+
+/**
+ * @brief Groups the n-th bytes of all elements together. `dest` must not overlap `src`.
+ *
+ * The element size is a compile-time constant, so the strided loops can be unrolled/vectorized by the compiler.
+ *
+ * @tparam ElementSize Size of each element in bytes (e.g. 4 for float arrays).
+ * @return false if the destination buffer is smaller than the source buffer.
+ */
+template<std::size_t ElementSize>
+requires(ElementSize > 0)
+bool byte_shuffle(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+{
+  if (dest.size() < src.size()) {
+    return false;
+  }
+  detail::byte_shuffle<ElementSize>(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size());
+  return true;
+}
+
+template<std::size_t ElementSize>
+requires(ElementSize > 0)
+bool byte_unshuffle(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+{
+  if (dest.size() < src.size()) {
+    return false;
+  }
+  detail::byte_unshuffle<ElementSize>(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size());
+  return true;
+}
+
+/**
+ * @brief Groups the n-th bits of all elements together (bit planes). `dest` must not overlap `src`.
+ *
+ * Effective for values with a small dynamic range (counters, ADC readings, slowly changing measurements).
+ */
+template<std::size_t ElementSize>
+requires(ElementSize > 0)
+bool bit_shuffle(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+{
+  if (dest.size() < src.size()) {
+    return false;
+  }
+  detail::bit_shuffle<ElementSize>(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size());
+  return true;
+}
+
+template<std::size_t ElementSize>
+requires(ElementSize > 0)
+bool bit_unshuffle(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+{
+  if (dest.size() < src.size()) {
+    return false;
+  }
+  detail::bit_unshuffle<ElementSize>(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size());
+  return true;
+}
+
+/**
+ * @brief Maximum size of LZ compressed data for the given input size (incompressible data).
+ */
+constexpr std::size_t lz_compress_bound(const std::size_t size) noexcept
+{
+  return size + size / 255 + 16;
+}
+
+/**
+ * @brief Compresses `src` into `dest` with the LZ codec. `dest` must not overlap `src`.
+ *
+ * @return buffer_view of the compressed data in `dest`, or an empty buffer_view if `dest` is too small.
+ */
+inline bytepack::buffer_view lz_compress(const bytepack::const_buffer_view& src,
+                                         const bytepack::buffer_view& dest) noexcept
+{
+  constexpr std::size_t min_match = 4;
+  constexpr std::size_t max_offset = 65535;
+  constexpr std::size_t hash_bits = 12;
+
+  const std::uint8_t* in = src.as<std::uint8_t>();
+  const std::size_t in_size = src.size();
+  std::uint8_t* out = dest.as<std::uint8_t>();
+  const std::size_t out_size = dest.size();
+  std::size_t op = 0;
+
+  const auto put_length = [&](std::size_t length) {
+    for (; length >= 255; length -= 255) {
+      if (op >= out_size) {
+        return false;
+      }
+      out[op++] = 255;
+    }
+    if (op >= out_size) {
+      return false;
+    }
+    out[op++] = static_cast<std::uint8_t>(length);
+    return true;
+  };
+
+  const auto put_sequence = [&](const std::size_t literal_begin, const std::size_t literal_length,
+                                const std::size_t offset, const std::size_t match_length) {
+    const std::size_t lit_nibble = std::min<std::size_t>(literal_length, 15);
+    const std::size_t match_nibble = match_length == 0 ? 0 : std::min<std::size_t>(match_length - min_match, 15);
+    if (op >= out_size) {
+      return false;
+    }
+    out[op++] = static_cast<std::uint8_t>((lit_nibble << 4) | match_nibble);
+    if (lit_nibble == 15 && put_length(literal_length - 15) == false) {
+      return false;
+    }
+    if (out_size - op < literal_length) {
+      return false;
+    }
+    std::memcpy(out + op, in + literal_begin, literal_length);
+    op += literal_length;
+    if (match_length == 0) {
+      return true; // last sequence
+    }
+    if (out_size - op < 2) {
+      return false;
+    }
+    out[op++] = static_cast<std::uint8_t>(offset & 0xFF);
+    out[op++] = static_cast<std::uint8_t>(offset >> 8);
+    return match_nibble != 15 || put_length(match_length - min_match - 15);
+  };
+
+  const auto read32 = [in](const std::size_t pos) {
+    std::uint32_t value{};
+    std::memcpy(&value, in + pos, sizeof(value));
+    return value;
+  };
+
+  std::array<std::uint32_t, std::size_t{ 1 } << hash_bits> table{};
+  std::size_t anchor = 0;
+  std::size_t ip = 0;
+  while (in_size >= min_match && ip <= in_size - min_match) {
+    const std::uint32_t sequence = read32(ip);
+    const auto hash = static_cast<std::size_t>((sequence * 2654435761U) >> (32 - hash_bits));
+    const std::size_t candidate = table[hash];
+    table[hash] = static_cast<std::uint32_t>(ip);
+
+    if (candidate < ip && ip - candidate <= max_offset && read32(candidate) == sequence) {
+      std::size_t match_length = min_match;
+      while (ip + match_length < in_size && in[candidate + match_length] == in[ip + match_length]) {
+        ++match_length;
+      }
+      if (put_sequence(anchor, ip - anchor, ip - candidate, match_length) == false) {
+        return detail::empty_view();
+      }
+      ip += match_length;
+      anchor = ip;
+    } else {
+      // Skip faster through incompressible data
+      ip += 1 + ((ip - anchor) >> 6);
+    }
+  }
+
+  if (put_sequence(anchor, in_size - anchor, 0, 0) == false) {
+    return detail::empty_view();
+  }
+  return bytepack::buffer_view(out, op);
+}
+
+/**
+ * @brief Decompresses LZ compressed data into `dest`. Malformed input never reads or writes out of bounds.
+ *
+ * @return buffer_view of the decompressed data in `dest`, or an empty buffer_view if the input is malformed or `dest`
+ * is too small.
+ */
+inline bytepack::buffer_view lz_decompress(const bytepack::const_buffer_view& src,
+                                           const bytepack::buffer_view& dest) noexcept
+{
+  const std::uint8_t* in = src.as<std::uint8_t>();
+  const std::size_t in_size = src.size();
+  std::uint8_t* out = dest.as<std::uint8_t>();
+  const std::size_t out_size = dest.size();
+  std::size_t ip = 0;
+  std::size_t op = 0;
+
+  const auto get_length = [&](std::size_t& length) {
+    std::uint8_t byte = 255;
+    while (byte == 255) {
+      if (ip >= in_size) {
+        return false;
+      }
+      byte = in[ip++];
+      length += byte;
+    }
+    return true;
+  };
+
+  while (ip < in_size) {
+    const std::uint8_t token = in[ip++];
+
+    std::size_t literal_length = token >> 4;
+    if ((literal_length == 15 && get_length(literal_length) == false) || in_size - ip < literal_length
+        || out_size - op < literal_length) {
+      return detail::empty_view();
+    }
+    std::memcpy(out + op, in + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == in_size) {
+      return bytepack::buffer_view(out, op); // last sequence
+    }
+
+    if (in_size - ip < 2) {
+      return detail::empty_view();
+    }
+    const std::size_t offset = static_cast<std::size_t>(in[ip]) | (static_cast<std::size_t>(in[ip + 1]) << 8);
+    ip += 2;
+
+    std::size_t match_length = token & 0x0F;
+    if ((match_length == 15 && get_length(match_length) == false) || offset == 0 || offset > op) {
+      return detail::empty_view();
+    }
+    match_length += 4;
+    if (out_size - op < match_length) {
+      return detail::empty_view();
+    }
+
+    if (offset >= match_length) {
+      std::memcpy(out + op, out + op - offset, match_length);
+      op += match_length;
+    } else {
+      // Overlapping match (repeated pattern) must be copied byte by byte
+      for (std::size_t i = 0; i < match_length; ++i, ++op) {
+        out[op] = out[op - offset];
+      }
+    }
+  }
+
+  return detail::empty_view(); // last sequence is missing
+}
+
+/**
+ * @class compression_stage
+ * @brief Post-serialization stage applying an optional shuffle filter and the LZ codec to serialized data (e.g.
+ * `binary_stream::data()`), producing self-describing frames.
+ *
+ * It keeps a scratch buffer for the shuffle filter that grows to the largest message and is reused afterwards.
+ */
+class compression_stage final
+{
+public:
+  static constexpr std::size_t header_size = sizeof(std::uint8_t) + sizeof(std::uint8_t) + sizeof(std::uint32_t);
+
+  /**
+   * @brief Maximum frame size for the given uncompressed size.
+   */
+  static constexpr std::size_t frame_bound(const std::size_t size) noexcept
+  {
+    return header_size + lz_compress_bound(size);
+  }
+
+  /**
+   * @brief Compresses serialized data into a frame in `dest`.
+   *
+   * @tparam Filter Shuffle filter applied before compression.
+   * @tparam ElementSize Size of the array elements in bytes for the shuffle filter (e.g. 4 for float arrays).
+   * @return buffer_view of the frame in `dest`, or an empty buffer_view if `dest` is too small.
+   */
+  template<shuffle_filter Filter = shuffle_filter::none, std::size_t ElementSize = 1>
+  requires(ElementSize > 0 && ElementSize <= 255)
+  bytepack::buffer_view compress(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+  {
+    if (src.size() > std::numeric_limits<std::uint32_t>::max() || dest.size() < header_size) {
+      return detail::empty_view();
+    }
+
+    bytepack::binary_stream header(dest);
+    header.write(Filter, static_cast<std::uint8_t>(ElementSize), static_cast<std::uint32_t>(src.size()));
+
+    bytepack::const_buffer_view input = src;
+    if constexpr (Filter != shuffle_filter::none) {
+      scratch_.resize(src.size());
+      const bytepack::buffer_view shuffled(scratch_.data(), scratch_.size());
+      if constexpr (Filter == shuffle_filter::byte) {
+        byte_shuffle<ElementSize>(src, shuffled);
+      } else {
+        bit_shuffle<ElementSize>(src, shuffled);
+      }
+      input = shuffled;
+    }
+
+    const bytepack::buffer_view payload =
+      lz_compress(input, bytepack::buffer_view(dest.as<std::uint8_t>() + header_size, dest.size() - header_size));
+    if (payload.is_empty()) {
+      return detail::empty_view();
+    }
+    return bytepack::buffer_view(dest.as<std::uint8_t>(), header_size + payload.size());
+  }
+
+  /**
+   * @brief Decompresses a frame into `dest`, which can then be deserialized with a binary_stream.
+   *
+   * @return buffer_view of the decompressed data in `dest`, or an empty buffer_view if the frame is malformed or `dest`
+   * is too small.
+   */
+  bytepack::buffer_view decompress(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest) noexcept
+  {
+    bytepack::binary_reader header(src);
+    shuffle_filter filter{};
+    std::uint8_t element_size{};
+    std::uint32_t size{};
+    if (header.read(filter, element_size, size) == false || element_size == 0 || dest.size() < size) {
+      return detail::empty_view();
+    }
+
+    const bytepack::const_buffer_view payload(src.as<std::uint8_t>() + header_size, src.size() - header_size);
+    if (filter == shuffle_filter::none) {
+      const bytepack::buffer_view output = lz_decompress(payload, dest);
+      return output.size() == size ? output : detail::empty_view();
+    }
+    if (filter != shuffle_filter::byte && filter != shuffle_filter::bit) {
+      return detail::empty_view();
+    }
+
+    scratch_.resize(size);
+    const bytepack::buffer_view shuffled = lz_decompress(payload, bytepack::buffer_view(scratch_.data(), size));
+    if (shuffled.size() != size) {
+      return detail::empty_view();
+    }
+
+    const bytepack::buffer_view output(dest.as<std::uint8_t>(), size);
+    if (filter == shuffle_filter::byte) {
+      unshuffle<false>(shuffled, output, element_size);
+    } else {
+      unshuffle<true>(shuffled, output, element_size);
+    }
+    return output;
+  }
+
+private:
+  // Dispatches common element sizes to the specialized (compile-time stride) implementations
+  template<bool BitShuffle>
+  static void unshuffle(const bytepack::const_buffer_view& src, const bytepack::buffer_view& dest,
+                        const std::size_t element_size) noexcept
+  {
+    const auto dispatch = [&]<std::size_t ElementSize>() {
+      if constexpr (BitShuffle) {
+        bit_unshuffle<ElementSize>(src, dest);
+      } else {
+        byte_unshuffle<ElementSize>(src, dest);
+      }
+    };
+
+    switch (element_size) {
+    case 2:
+      dispatch.template operator()<2>();
+      break;
+    case 4:
+      dispatch.template operator()<4>();
+      break;
+    case 8:
+      dispatch.template operator()<8>();
+      break;
+    default:
+      if constexpr (BitShuffle) {
+        detail::bit_unshuffle(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size(), element_size);
+      } else {
+        detail::byte_unshuffle(src.as<std::uint8_t>(), dest.as<std::uint8_t>(), src.size(), element_size);
+      }
+      break;
+    }
+  }
+
+  std::vector<std::uint8_t> scratch_;
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_COMPRESSION_HPP
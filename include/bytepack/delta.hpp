@@ -0,0 +1,233 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file delta.hpp
+ * @brief Optional delta encoding of successive fixed-layout messages. Only the fields that changed since the previous
+ * message of the same stream are serialized, preceded by a bitmap of changed fields. Key frames carrying all fields are
+ * sent periodically so that a receiver can (re)synchronize.
+ *
+ * Frame format (in the endianness of the binary_stream):
+ * - Key frame:   frame type (std::uint8_t, 0) + all fields
+ * - Delta frame: frame type (std::uint8_t, 1) + changed-field bitmap (ceil(N / 8) bytes, bit i of byte i / 8 is
+ *                field i, least significant bit first) + changed fields in layout order
+ */
+
+#ifndef BYTEPACK_DELTA_HPP
+#define BYTEPACK_DELTA_HPP
+
+#include <utility>
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+enum class delta_frame_type : std::uint8_t { key_frame = 0, delta_frame = 1 };
+
+template<FieldLayout Layout, std::endian BufferEndian = std::endian::big>
+class delta_encoder;
+
+template<FieldLayout Layout, std::endian BufferEndian = std::endian::big>
+class delta_decoder;
+
+/**
+ * @class delta_encoder
+ * @brief Keeps the previous snapshot of a message stream and serializes only the changed fields.
+ *
+ * @tparam Layout field_layout of the message.
+ * @tparam BufferEndian The endianness to use for serialization. Defaults to big-endian (network byte order).
+ */
+template<typename... Fields, std::endian BufferEndian>
+class delta_encoder<field_layout<Fields...>, BufferEndian> final
+{
+  using Layout = field_layout<Fields...>;
+  using bitmap_type = std::array<std::uint8_t, (Layout::field_count + 7) / 8>;
+
+public:
+  /**
+   * @param key_frame_interval A key frame is sent every `key_frame_interval` frames. If it is 0, only the first frame
+   *                           (and frames requested by `force_key_frame()`) are key frames.
+   */
+  explicit constexpr delta_encoder(const std::size_t key_frame_interval = 0) noexcept
+    : key_frame_interval_{ key_frame_interval }
+  {}
+
+  /**
+   * @brief Serializes the message as a key frame or a delta frame against the previous message.
+   *
+   * The snapshot is updated only if the frame is serialized successfully.
+   */
+  bool encode(binary_stream<BufferEndian>& stream, const Fields&... values) noexcept
+  {
+    std::array<std::uint8_t, Layout::size> current{};
+    binary_stream<BufferEndian> current_stream{ bytepack::buffer_view(current) };
+    if (current_stream.write(values...) == false) {
+      return false;
+    }
+
+    const bool key_frame = has_snapshot_ == false
+                           || (key_frame_interval_ != 0 && frames_since_key_frame_ + 1 >= key_frame_interval_);
+
+    // The frame is assembled from the serialized fields and written at once, so a frame that does not fit leaves the
+    // stream unchanged
+    std::array<std::uint8_t, 1 + sizeof(bitmap_type) + Layout::size> frame{};
+    std::size_t frame_size = 1;
+    if (key_frame) {
+      frame[0] = static_cast<std::uint8_t>(delta_frame_type::key_frame);
+      std::memcpy(frame.data() + 1, current.data(), current.size());
+      frame_size += current.size();
+    } else {
+      bitmap_type changed{};
+      frame[0] = static_cast<std::uint8_t>(delta_frame_type::delta_frame);
+      frame_size += sizeof(bitmap_type);
+      frame_size += append_changed(current, changed, frame.data() + frame_size, std::index_sequence_for<Fields...>{});
+      std::memcpy(frame.data() + 1, changed.data(), changed.size());
+    }
+
+    if (stream.write_bytes(bytepack::const_buffer_view(frame.data(), frame_size)) == false) {
+      return false;
+    }
+
+    previous_ = current;
+    has_snapshot_ = true;
+    frames_since_key_frame_ = key_frame ? 0 : frames_since_key_frame_ + 1;
+    return true;
+  }
+
+  /**
+   * @brief Makes the next frame a key frame (e.g. when a new receiver joins the stream).
+   */
+  constexpr void force_key_frame() noexcept { has_snapshot_ = false; }
+
+private:
+  // Marks the fields that differ from the snapshot and appends their serialized bytes to `out`. Returns the number of
+  // appended bytes.
+  template<std::size_t... Is>
+  std::size_t append_changed(const std::array<std::uint8_t, Layout::size>& current, bitmap_type& changed,
+                             std::uint8_t* out, std::index_sequence<Is...>) const noexcept
+  {
+    std::size_t size = 0;
+    const auto append = [&](const std::size_t index, const std::size_t offset, const std::size_t field_size) {
+      if (std::memcmp(current.data() + offset, previous_.data() + offset, field_size) != 0) {
+        changed[index / 8] |= static_cast<std::uint8_t>(1U << (index % 8));
+        std::memcpy(out + size, current.data() + offset, field_size);
+        size += field_size;
+      }
+    };
+    (append(Is, Layout::template offset<Is>, wire_size_v<Fields>), ...);
+    return size;
+  }
+
+  std::array<std::uint8_t, Layout::size> previous_{};
+  std::size_t key_frame_interval_;
+  std::size_t frames_since_key_frame_{ 0 };
+  bool has_snapshot_{ false };
+};
+
+/**
+ * @class delta_decoder
+ * @brief Reconstructs full messages from key frames and delta frames produced by delta_encoder.
+ *
+ * Delta frames received before the first key frame cannot be decoded and are rejected.
+ *
+ * @tparam Layout field_layout of the message.
+ * @tparam BufferEndian The endianness to use for deserialization. Defaults to big-endian (network byte order).
+ */
+template<typename... Fields, std::endian BufferEndian>
+class delta_decoder<field_layout<Fields...>, BufferEndian> final
+{
+  using Layout = field_layout<Fields...>;
+  using bitmap_type = std::array<std::uint8_t, (Layout::field_count + 7) / 8>;
+
+public:
+  /**
+   * @brief Deserializes a frame and writes the full (reconstructed) message to the given fields.
+   *
+   * The snapshot is updated only if the frame is deserialized successfully. An unknown frame type, a delta frame
+   * before the first key frame and a bitmap with bits beyond the last field fail with `error_code::invalid_value`.
+   * If the fields of a frame are truncated, the fields before the failing one are already overwritten.
+   */
+  bool decode(binary_stream<BufferEndian>& stream, Fields&... values) noexcept
+  {
+    const std::size_t frame_offset = stream.read_offset();
+    delta_frame_type frame_type{};
+    if (stream.read(frame_type) == false) {
+      return false;
+    }
+
+    binary_stream<BufferEndian> snapshot_stream{ bytepack::buffer_view(snapshot_) };
+
+    if (frame_type == delta_frame_type::key_frame) {
+      if (stream.read(values...) == false) {
+        return false;
+      }
+      has_snapshot_ = snapshot_stream.write(values...);
+      return true;
+    }
+
+    if (frame_type != delta_frame_type::delta_frame || has_snapshot_ == false) {
+      return stream.set_error(error_code::invalid_value, frame_offset);
+    }
+
+    bitmap_type changed{};
+    if (stream.read(changed) == false) {
+      return false;
+    }
+    if (has_unknown_fields(changed)) {
+      return stream.set_error(error_code::invalid_value, frame_offset + sizeof(frame_type));
+    }
+
+    if (read_changed(stream, changed, std::index_sequence_for<Fields...>{}, values...) == false) {
+      return false;
+    }
+
+    merge(snapshot_stream, changed, std::index_sequence_for<Fields...>{}, values...);
+    return true;
+  }
+
+  /**
+   * @brief Drops the snapshot; delta frames are rejected until the next key frame.
+   */
+  constexpr void reset() noexcept { has_snapshot_ = false; }
+
+private:
+  static constexpr bool has_unknown_fields(const bitmap_type& changed) noexcept
+  {
+    constexpr std::size_t used_bits = Layout::field_count % 8;
+    return used_bits != 0 && (changed.back() >> used_bits) != 0;
+  }
+
+  template<std::size_t... Is>
+  static bool read_changed(binary_stream<BufferEndian>& stream, const bitmap_type& changed, std::index_sequence<Is...>,
+                           Fields&... values) noexcept
+  {
+    return (... && ((changed[Is / 8] & (1U << (Is % 8))) == 0 || stream.read(values)));
+  }
+
+  // Stores the changed fields in the snapshot and loads the unchanged ones from it
+  template<std::size_t... Is>
+  static void merge(binary_stream<BufferEndian>& snapshot_stream, const bitmap_type& changed,
+                    std::index_sequence<Is...>, Fields&... values) noexcept
+  {
+    (static_cast<void>((changed[Is / 8] & (1U << (Is % 8))) != 0
+                         ? snapshot_stream.template write_field<Layout::template offset<Is>>(values)
+                         : snapshot_stream.template read_field<Layout::template offset<Is>>(values)),
+     ...);
+  }
+
+  std::array<std::uint8_t, Layout::size> snapshot_{};
+  bool has_snapshot_{ false };
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_DELTA_HPP
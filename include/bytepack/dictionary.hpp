@@ -0,0 +1,209 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file dictionary.hpp
+ * @brief Optional batch-scoped dictionary encoding of repeated strings (e.g. device IDs and serial numbers in a batch
+ * of messages). The first occurrence of a string in a batch is written once and added to the string table; later
+ * occurrences are written as a varint index into the table (1 byte for the first 127 strings).
+ *
+ *   bytepack::dictionary_encoder encoder;
+ *   for (const auto& msg : batch) {
+ *     stream.write(msg.timestamp) && encoder.write(stream, msg.device_id) && stream.write(msg.value);
+ *   }
+ *
+ *   bytepack::dictionary_decoder decoder;
+ *   std::string_view device_id; // refers to the received buffer, no copy
+ *   stream.read(timestamp) && decoder.read(stream, device_id) && stream.read(value);
+ *
+ * Format of a string field (the string table is built inline, in the order of first occurrence):
+ * - First occurrence: varint 0 + string with a `SizeType` length prefix (same as `binary_stream::write<SizeType>`)
+ * - Repeated string: varint (table index + 1)
+ *
+ * Varints are unsigned LEB128 (7 bits per byte, least significant group first). The encoder and the decoder must be
+ * `reset()` at the same batch boundaries.
+ */
+
+#ifndef BYTEPACK_DICTIONARY_HPP
+#define BYTEPACK_DICTIONARY_HPP
+
+#include <functional>
+#include <unordered_map>
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+namespace detail {
+
+inline constexpr std::size_t max_varint32_size = 5;
+
+template<std::endian BufferEndian, StreamInstrumentation Instrumentation>
+bool write_varint(binary_stream<BufferEndian, Instrumentation>& stream, std::uint32_t value) noexcept
+{
+  while (value >= 0x80) {
+    if (stream.write(static_cast<std::uint8_t>(value | 0x80)) == false) {
+      return false;
+    }
+    value >>= 7;
+  }
+  return stream.write(static_cast<std::uint8_t>(value));
+}
+
+template<std::endian BufferEndian, StreamInstrumentation Instrumentation, bool ReadOnly>
+bool read_varint(binary_stream<BufferEndian, Instrumentation, ReadOnly>& stream, std::uint32_t& value) noexcept
+{
+  value = 0;
+  for (std::size_t i = 0; i < max_varint32_size; ++i) {
+    std::uint8_t byte{};
+    if (stream.read(byte) == false) {
+      return false;
+    }
+    if (i == max_varint32_size - 1 && byte > 0x0F) {
+      return false; // more than 32 bits
+    }
+    value |= static_cast<std::uint32_t>(byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Transparent hash for std::string_view lookups in std::string keyed maps
+struct string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(const std::string_view value) const noexcept { return std::hash<std::string_view>{}(value); }
+};
+
+} // namespace detail
+
+/**
+ * @class dictionary_encoder
+ * @brief Writes strings as string table entries (first occurrence) or varint table indices (see the file description).
+ *
+ * @tparam SizeType Length prefix type of the strings in the table.
+ */
+template<IntegralType SizeType = std::uint16_t>
+class dictionary_encoder final
+{
+public:
+  /**
+   * @brief Writes the string, or its table index if it was already written in the current batch.
+   */
+  template<std::endian BufferEndian, StreamInstrumentation Instrumentation>
+  bool write(binary_stream<BufferEndian, Instrumentation>& stream, const std::string_view value)
+  {
+    if (const auto entry = table_.find(value); entry != table_.end()) {
+      return detail::write_varint(stream, entry->second + 1);
+    }
+
+    if (table_.size() >= std::numeric_limits<std::uint32_t>::max() || !detail::write_varint(stream, 0)
+        || !stream.template write<SizeType>(value)) {
+      return false;
+    }
+    table_.emplace(std::string(value), static_cast<std::uint32_t>(table_.size()));
+    return true;
+  }
+
+  /**
+   * @brief Writes a fixed-size character array field (all N characters, including any null padding). Note that a
+   * string literal is a character array: pass `std::string_view("...")` to omit its null terminator.
+   */
+  template<std::endian BufferEndian, StreamInstrumentation Instrumentation, std::size_t N>
+  bool write(binary_stream<BufferEndian, Instrumentation>& stream, const char (&value)[N])
+  {
+    return write(stream, std::string_view(value, N));
+  }
+
+  /**
+   * @brief Clears the string table at the start of a new batch.
+   */
+  void reset() noexcept { table_.clear(); }
+
+  /**
+   * @brief Returns the number of strings in the table.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return table_.size(); }
+
+private:
+  std::unordered_map<std::string, std::uint32_t, detail::string_hash, std::equal_to<>> table_;
+};
+
+/**
+ * @class dictionary_decoder
+ * @brief Reads strings written by dictionary_encoder as `std::string_view`s into the buffer of the stream. The views
+ * are valid as long as the buffer.
+ *
+ * @tparam SizeType Length prefix type of the strings in the table (same as the encoder).
+ */
+template<IntegralType SizeType = std::uint16_t>
+class dictionary_decoder final
+{
+public:
+  /**
+   * @return false if the stream fails or the table index is invalid.
+   */
+  template<std::endian BufferEndian, StreamInstrumentation Instrumentation, bool ReadOnly>
+  bool read(binary_stream<BufferEndian, Instrumentation, ReadOnly>& stream, std::string_view& value)
+  {
+    std::uint32_t tag{};
+    if (!detail::read_varint(stream, tag)) {
+      return false;
+    }
+    if (tag == 0) {
+      if (!stream.template read<SizeType>(value)) {
+        return false;
+      }
+      table_.push_back(value);
+      return true;
+    }
+    if (tag > table_.size()) {
+      return false;
+    }
+    value = table_[tag - 1];
+    return true;
+  }
+
+  /**
+   * @brief Reads a fixed-size character array field; the string must have exactly N characters.
+   */
+  template<std::endian BufferEndian, StreamInstrumentation Instrumentation, bool ReadOnly, std::size_t N>
+  bool read(binary_stream<BufferEndian, Instrumentation, ReadOnly>& stream, char (&value)[N])
+  {
+    std::string_view view;
+    if (!read(stream, view) || view.size() != N) {
+      return false;
+    }
+    std::memcpy(value, view.data(), N);
+    return true;
+  }
+
+  /**
+   * @brief Clears the string table at the start of a new batch.
+   */
+  void reset() noexcept { table_.clear(); }
+
+  /**
+   * @brief Returns the string table of the current batch.
+   */
+  [[nodiscard]] const std::vector<std::string_view>& table() const noexcept { return table_; }
+
+private:
+  std::vector<std::string_view> table_;
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_DICTIONARY_HPP
@@ -0,0 +1,397 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file file_sink.hpp
+ * @brief Optional asynchronous file sink for record logs (POSIX). Records are serialized with `binary_stream` into
+ * one of N large buffers, while a background thread writes the full buffers to the file with large sequential
+ * writes. The serializing thread does not make system calls, except when it hands over a full buffer.
+ *
+ *   bytepack::file_sink sink("messages.log");
+ *   sink.append([&](auto& stream) { return msg.serialize(stream); });
+ *   sink.close(); // or destructor
+ *
+ * Options:
+ * - Back-pressure: if all buffers are waiting to be written, `append` blocks (`backpressure_policy::block`) or drops
+ *   the record (`backpressure_policy::drop`, counted by `dropped_records()`).
+ * - Durability: no `fsync` (`sync_policy::none`), once on close (`sync_policy::on_close`) or after each buffer write
+ *   (`sync_policy::every_write`).
+ * - Direct I/O (`O_DIRECT`, Linux): buffers are aligned to and sized in 4 KiB blocks to bypass the page cache. Only
+ *   whole blocks of full buffers are written; the remaining bytes are moved to the next buffer, which has one extra
+ *   block for them. After a partially filled buffer is written (`flush()`), the rest of the file is written through
+ *   the page cache. If the file system does not support direct I/O, or an appended file does not end on a block
+ *   boundary, the page cache is used.
+ *
+ * The background thread is a `std::thread`: link the program with the threads library (`Threads::Threads` in CMake,
+ * `-pthread`). The `bytepack` CMake target does not link it, as the rest of the library does not need it.
+ */
+
+#ifndef BYTEPACK_FILE_SINK_HPP
+#define BYTEPACK_FILE_SINK_HPP
+
+#if !defined(_WIN32)
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "aligned_buffer.hpp"
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+enum class backpressure_policy : std::uint8_t { block, drop };
+
+enum class sync_policy : std::uint8_t { none, on_close, every_write };
+
+struct file_sink_options
+{
+  std::size_t buffer_size = 4 * 1024 * 1024;
+  std::size_t buffer_count = 2; // at least 2: one is filled while the others are written
+  backpressure_policy backpressure = backpressure_policy::block;
+  sync_policy sync = sync_policy::on_close;
+  bool direct_io = false;
+  bool append_to_file = false; // otherwise the file is truncated
+  page_mode pages = page_mode::default_pages;
+};
+
+/**
+ * @class file_sink
+ * @brief Double-buffered (N-buffered) file writer with a background flush thread (see the file description).
+ *
+ * `append` and `flush` must be called from a single thread.
+ */
+class file_sink final
+{
+public:
+  static constexpr std::size_t direct_io_block_size = 4096;
+
+  explicit file_sink(const char* path, const file_sink_options& options = {})
+    : options_{ options }
+  {
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (options.append_to_file ? O_APPEND : O_TRUNC);
+#if defined(O_DIRECT)
+    if (options.direct_io) {
+      fd_ = ::open(path, flags | O_DIRECT, 0644);
+      direct_ = fd_ >= 0;
+      // With O_APPEND every write starts at the end of the file, which must be block aligned for direct I/O
+      struct stat status{};
+      if (direct_ && options.append_to_file
+          && (::fstat(fd_, &status) != 0 || static_cast<std::size_t>(status.st_size) % direct_io_block_size != 0)) {
+        static_cast<void>(::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT));
+        direct_ = false;
+      }
+    }
+#endif
+    if (fd_ < 0) {
+      fd_ = ::open(path, flags, 0644);
+    }
+    if (fd_ < 0) {
+      error_ = errno;
+      return;
+    }
+
+    const std::size_t block = direct_ ? direct_io_block_size : 1;
+    record_capacity_ = (std::max<std::size_t>(options.buffer_size, 1) + block - 1) / block * block;
+    const std::size_t buffer_count = std::max<std::size_t>(options.buffer_count, 2);
+    buffers_.reserve(buffer_count);
+    for (std::size_t i = 0; i < buffer_count; ++i) {
+      // With direct I/O, the extra block holds the bytes moved over from the previous buffer
+      buffers_.emplace_back(direct_ ? record_capacity_ + block : record_capacity_, options.pages, block);
+      if (!buffers_.back()) {
+        error_ = ENOMEM;
+        ::close(fd_);
+        fd_ = -1;
+        return;
+      }
+      free_.push_back(i);
+    }
+    flusher_ = std::thread([this] { flush_loop(); });
+  }
+
+  ~file_sink() { close(); }
+
+  file_sink(const file_sink&) = delete;
+  file_sink& operator=(const file_sink&) = delete;
+  file_sink(file_sink&&) = delete;
+  file_sink& operator=(file_sink&&) = delete;
+
+  /**
+   * @brief Serializes a record into the active buffer. The serializer is called with a `binary_stream` over the
+   * remaining space of the buffer and returns true on success. If the record does not fit, the buffer is handed over
+   * to the background thread and the record is serialized into the next buffer. Records of up to `buffer_size` bytes
+   * always fit. Only a `buffer_overflow` error of the stream is retried; other failures of the serializer (e.g.
+   * `size_overflow`) return false with the buffer unchanged.
+   *
+   * @return false if the record is dropped (back-pressure), larger than a buffer, fails to serialize, or the sink is in
+   * an error state.
+   */
+  template<std::endian BufferEndian = std::endian::big, typename Serializer>
+  requires std::invocable<Serializer&, binary_stream<BufferEndian>&>
+  bool append(Serializer&& serializer)
+  {
+    if (fd_ < 0 || error_.load(std::memory_order_relaxed) != 0) {
+      return false;
+    }
+    if (active_ == no_buffer && (active_ = acquire_buffer()) == no_buffer) {
+      return drop_record();
+    }
+
+    for (bool switched = false;; switched = true) {
+      aligned_buffer& buffer = buffers_[active_];
+      binary_stream<BufferEndian> stream{ bytepack::buffer_view(buffer.data() + fill_, buffer.size() - fill_) };
+      if (static_cast<bool>(serializer(stream))) {
+        fill_ += stream.data().size();
+        return true;
+      }
+      if (stream.error().code != error_code::buffer_overflow || fill_ == 0 || switched) {
+        return false; // not a lack of space, or larger than a buffer
+      }
+      if (!next_buffer()) {
+        return drop_record();
+      }
+    }
+  }
+
+  /**
+   * @brief Appends already serialized bytes as a record.
+   */
+  bool append(const bytepack::const_buffer_view& record)
+  {
+    if (fd_ < 0 || error_.load(std::memory_order_relaxed) != 0 || record.size() > record_capacity_) {
+      return false;
+    }
+    if (active_ == no_buffer && (active_ = acquire_buffer()) == no_buffer) {
+      return drop_record();
+    }
+    if (record.size() > buffers_[active_].size() - fill_) {
+      if (!next_buffer()) {
+        return drop_record();
+      }
+    }
+    if (record.size() > 0) {
+      std::memcpy(buffers_[active_].data() + fill_, record.as<void>(), record.size());
+      fill_ += record.size();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Hands the active (partially filled) buffer over to the background thread. It does not wait for the write.
+   */
+  void flush()
+  {
+    if (active_ != no_buffer && fill_ > 0) {
+      submit(active_, fill_);
+      active_ = no_buffer;
+      fill_ = 0;
+    }
+  }
+
+  /**
+   * @brief Writes the remaining records, waits for the background thread, applies the sync policy and closes the file.
+   *
+   * @return false if any write or sync failed (see `error()`).
+   */
+  bool close()
+  {
+    if (fd_ < 0) {
+      return error_ == 0;
+    }
+    flush();
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_available_.notify_one();
+    flusher_.join();
+
+    if (options_.sync != sync_policy::none && error_ == 0 && ::fsync(fd_) != 0) {
+      error_ = errno;
+    }
+    ::close(fd_);
+    fd_ = -1;
+    return error_ == 0;
+  }
+
+  [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+  /**
+   * @brief Returns the first `errno` value of a failed open, write or sync, 0 if there is no error.
+   */
+  [[nodiscard]] int error() const noexcept { return error_.load(); }
+
+  /**
+   * @brief Returns the number of bytes written to the file by the background thread.
+   */
+  [[nodiscard]] std::uint64_t bytes_written() const noexcept { return bytes_written_.load(); }
+
+  [[nodiscard]] std::uint64_t dropped_records() const noexcept { return dropped_records_; }
+
+  /**
+   * @brief Returns true if the file is written with direct I/O (`O_DIRECT`).
+   */
+  [[nodiscard]] bool direct_io() const noexcept { return direct_.load(); }
+
+private:
+  static constexpr std::size_t no_buffer = static_cast<std::size_t>(-1);
+
+  struct pending_write
+  {
+    std::size_t buffer;
+    std::size_t size;
+  };
+
+  // Returns a free buffer, or no_buffer if none is free with the drop policy
+  std::size_t acquire_buffer()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+      if (options_.backpressure == backpressure_policy::drop) {
+        return no_buffer;
+      }
+      buffer_available_.wait(lock, [this] { return !free_.empty(); });
+    }
+    const std::size_t buffer = free_.front();
+    free_.pop_front();
+    return buffer;
+  }
+
+  void submit(const std::size_t buffer, const std::size_t size)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      pending_.push_back(pending_write{ buffer, size });
+    }
+    work_available_.notify_one();
+  }
+
+  // Hands the active buffer over to the background thread and continues in a free buffer. With direct I/O, only whole
+  // blocks are handed over and the remaining bytes are moved to the start of the next buffer.
+  bool next_buffer()
+  {
+    const std::size_t next = acquire_buffer();
+    if (next == no_buffer) {
+      return false;
+    }
+    const std::size_t tail = direct_ ? fill_ % direct_io_block_size : 0;
+    if (tail > 0) {
+      std::memcpy(buffers_[next].data(), buffers_[active_].data() + (fill_ - tail), tail);
+    }
+    submit(active_, fill_ - tail);
+    active_ = next;
+    fill_ = tail;
+    return true;
+  }
+
+  bool drop_record() noexcept
+  {
+    ++dropped_records_;
+    return false;
+  }
+
+  void flush_loop()
+  {
+    for (;;) {
+      pending_write write{};
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_available_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) {
+          return;
+        }
+        write = pending_.front();
+        pending_.pop_front();
+      }
+
+      if (error_ == 0) {
+        write_buffer(buffers_[write.buffer].data(), write.size);
+      }
+
+      {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(write.buffer);
+      }
+      buffer_available_.notify_one();
+    }
+  }
+
+  void write_buffer(const std::uint8_t* data, std::size_t size)
+  {
+#if defined(O_DIRECT)
+    if (direct_ && size % direct_io_block_size != 0) {
+      // Direct I/O requires block-aligned sizes and file offsets: continue through the page cache
+      const int flags = ::fcntl(fd_, F_GETFL);
+      static_cast<void>(::fcntl(fd_, F_SETFL, flags & ~O_DIRECT));
+      direct_ = false;
+    }
+#endif
+    while (size > 0) {
+      const ssize_t result = ::write(fd_, data, size);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        error_ = errno;
+        return;
+      }
+      data += result;
+      size -= static_cast<std::size_t>(result);
+      bytes_written_ += static_cast<std::uint64_t>(result);
+    }
+    if (options_.sync == sync_policy::every_write) {
+#if defined(__linux__)
+      const int result = ::fdatasync(fd_);
+#else
+      const int result = ::fsync(fd_);
+#endif
+      if (result != 0) {
+        error_ = errno;
+      }
+    }
+  }
+
+  file_sink_options options_;
+  int fd_{ -1 };
+  std::atomic<bool> direct_{ false };
+  std::atomic<int> error_{ 0 };
+  std::atomic<std::uint64_t> bytes_written_{ 0 };
+  std::uint64_t dropped_records_{ 0 };
+
+  // Serializing thread only
+  std::size_t record_capacity_{ 0 }; // buffer size without the direct I/O block
+  std::size_t active_{ no_buffer };
+  std::size_t fill_{ 0 };
+
+  // Shared with the background thread (guarded by mutex_)
+  std::vector<aligned_buffer> buffers_;
+  std::deque<std::size_t> free_;
+  std::deque<pending_write> pending_;
+  bool stop_{ false };
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable buffer_available_;
+  std::thread flusher_;
+};
+
+} // namespace bytepack
+
+#endif // !defined(_WIN32)
+
+#endif // BYTEPACK_FILE_SINK_HPP
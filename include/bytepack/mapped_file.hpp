@@ -0,0 +1,393 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file mapped_file.hpp
+ * @brief Optional memory-mapped file reader and writer (POSIX) for large files of serialized records. Records are
+ * deserialized directly from the read-only mapping with `binary_reader`, without copying the file into a buffer.
+ *
+ * `mapped_file_reader` maps a window of the file (the whole file by default) with an access pattern hint
+ * (`madvise`). Files larger than the window are processed by remapping the window:
+ *
+ *   bytepack::mapped_file_reader reader("telemetry.bin", 256 * 1024 * 1024);
+ *   reader.for_each_record([&](auto& stream) { return msg.deserialize(stream) && process(msg); });
+ *
+ * `mapped_file_writer` maps the file for writing and grows it in chunks; the file is truncated to the written size on
+ * `close()`.
+ *
+ *   bytepack::mapped_file_writer writer("telemetry.bin");
+ *   writer.append([&](auto& stream) { return msg.serialize(stream); });
+ */
+
+#ifndef BYTEPACK_MAPPED_FILE_HPP
+#define BYTEPACK_MAPPED_FILE_HPP
+
+#if !defined(_WIN32)
+
+#include <cerrno>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+enum class access_pattern : std::uint8_t { normal, sequential, random, will_need };
+
+namespace detail {
+
+inline std::size_t page_size() noexcept
+{
+  static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return size;
+}
+
+inline void advise(void* address, const std::size_t length, const access_pattern pattern) noexcept
+{
+  int advice = POSIX_MADV_NORMAL;
+  switch (pattern) {
+    case access_pattern::sequential:
+      advice = POSIX_MADV_SEQUENTIAL;
+      break;
+    case access_pattern::random:
+      advice = POSIX_MADV_RANDOM;
+      break;
+    case access_pattern::will_need:
+      advice = POSIX_MADV_WILLNEED;
+      break;
+    case access_pattern::normal:
+      break;
+  }
+  static_cast<void>(::posix_madvise(address, length, advice)); // advisory
+}
+
+} // namespace detail
+
+/**
+ * @class mapped_file_reader
+ * @brief Read-only mapping of a file, or of a window of it. The mapped bytes must not be modified.
+ */
+class mapped_file_reader final
+{
+public:
+  /**
+   * @param window_size Maximum size of the mapping (rounded up to the page size), 0 maps the whole file.
+   */
+  explicit mapped_file_reader(const char* path, const std::size_t window_size = 0,
+                              const access_pattern pattern = access_pattern::sequential) noexcept
+    : pattern_{ pattern }
+  {
+    fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+    struct stat status
+    {};
+    if (fd_ < 0 || ::fstat(fd_, &status) != 0) {
+      error_ = errno;
+      return;
+    }
+    file_size_ = static_cast<std::uint64_t>(status.st_size);
+    const std::size_t page = detail::page_size();
+    window_size_ = window_size == 0 ? static_cast<std::size_t>(file_size_) : (window_size + page - 1) / page * page;
+    static_cast<void>(map(0));
+  }
+
+  ~mapped_file_reader() noexcept
+  {
+    unmap();
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  mapped_file_reader(const mapped_file_reader&) = delete;
+  mapped_file_reader& operator=(const mapped_file_reader&) = delete;
+  mapped_file_reader(mapped_file_reader&&) = delete;
+  mapped_file_reader& operator=(mapped_file_reader&&) = delete;
+
+  /**
+   * @brief Maps the window that starts at the given file offset (the mapping itself starts at the page boundary).
+   *
+   * @return false if the offset is at or after the end of the file, or the mapping fails.
+   */
+  bool map(const std::uint64_t offset) noexcept
+  {
+    unmap();
+    if (fd_ < 0 || offset >= file_size_) {
+      return false;
+    }
+    const std::uint64_t page = detail::page_size();
+    const std::uint64_t mapping_offset = offset / page * page;
+    const std::size_t length = static_cast<std::size_t>(
+      std::min<std::uint64_t>(window_size_ + (offset - mapping_offset), file_size_ - mapping_offset));
+
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd_, static_cast<off_t>(mapping_offset));
+    if (address == MAP_FAILED) {
+      error_ = errno;
+      return false;
+    }
+    detail::advise(address, length, pattern_);
+    mapping_ = static_cast<std::uint8_t*>(address);
+    mapping_size_ = length;
+    view_offset_ = static_cast<std::size_t>(offset - mapping_offset);
+    offset_ = offset;
+    return true;
+  }
+
+  /**
+   * @brief Returns the mapped bytes from the offset of the last `map()` to the end of the window.
+   */
+  [[nodiscard]] bytepack::const_buffer_view view() const noexcept
+  {
+    return bytepack::const_buffer_view(mapping_ + view_offset_, mapping_size_ - view_offset_);
+  }
+
+  /**
+   * @brief Returns the file offset of `view()`.
+   */
+  [[nodiscard]] std::uint64_t offset() const noexcept { return offset_; }
+
+  [[nodiscard]] std::uint64_t file_size() const noexcept { return file_size_; }
+
+  /**
+   * @brief Returns true if the window reaches the end of the file.
+   */
+  [[nodiscard]] bool is_last_window() const noexcept { return offset_ + view().size() == file_size_; }
+
+  [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0 && error_ == 0; }
+
+  [[nodiscard]] int error() const noexcept { return error_; }
+
+  /**
+   * @brief Deserializes consecutive records from the current offset to the end of the file. The deserializer is
+   * called with a `binary_reader` and returns true on success. A record that crosses the end of the window is read
+   * again from a window that starts at the record.
+   *
+   * @return true if all records up to the end of the file are read; false if the deserializer fails (e.g. a
+   * truncated record at the end of the file, or a record larger than the window).
+   */
+  template<std::endian BufferEndian = std::endian::big, typename Deserializer>
+  requires std::invocable<Deserializer&, binary_reader<BufferEndian>&>
+  bool for_each_record(Deserializer&& deserializer)
+  {
+    if (mapping_ == nullptr) {
+      return fd_ >= 0 && offset_ >= file_size_;
+    }
+
+    for (;;) {
+      binary_reader<BufferEndian> stream{ view() };
+      std::size_t consumed = 0;
+      while (consumed < view().size() && static_cast<bool>(deserializer(stream))) {
+        if (stream.read_offset() == consumed) {
+          return false; // the deserializer does not read
+        }
+        consumed = stream.read_offset();
+      }
+
+      if (offset_ + consumed == file_size_) {
+        unmap();
+        offset_ = file_size_;
+        return true;
+      }
+      if (is_last_window() || consumed == 0) {
+        // Truncated record, or a record larger than the window: the view starts at the failing record
+        static_cast<void>(consumed > 0 && map(offset_ + consumed));
+        return false;
+      }
+      if (!map(offset_ + consumed)) {
+        return false;
+      }
+    }
+  }
+
+private:
+  void unmap() noexcept
+  {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      mapping_size_ = 0;
+      view_offset_ = 0;
+    }
+  }
+
+  int fd_{ -1 };
+  int error_{ 0 };
+  access_pattern pattern_;
+  std::uint64_t file_size_{ 0 };
+  std::size_t window_size_{ 0 };
+  std::uint8_t* mapping_{ nullptr };
+  std::size_t mapping_size_{ 0 };
+  std::size_t view_offset_{ 0 }; // offset of view() in the mapping
+  std::uint64_t offset_{ 0 };    // file offset of view()
+};
+
+/**
+ * @class mapped_file_writer
+ * @brief Writes serialized records to a memory-mapped file that grows in chunks.
+ */
+class mapped_file_writer final
+{
+public:
+  /**
+   * @param growth_size The file is extended by this size (rounded up to the page size) when a record does not fit.
+   *                    Records that do not fit after one extension (e.g. larger than it) are rejected.
+   */
+  explicit mapped_file_writer(const char* path, const std::size_t growth_size = 64 * 1024 * 1024) noexcept
+  {
+    const std::size_t page = detail::page_size();
+    growth_size_ = (std::max<std::size_t>(growth_size, 1) + page - 1) / page * page;
+    fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      error_ = errno;
+    }
+  }
+
+  ~mapped_file_writer() noexcept { static_cast<void>(close()); }
+
+  mapped_file_writer(const mapped_file_writer&) = delete;
+  mapped_file_writer& operator=(const mapped_file_writer&) = delete;
+  mapped_file_writer(mapped_file_writer&&) = delete;
+  mapped_file_writer& operator=(mapped_file_writer&&) = delete;
+
+  /**
+   * @brief Serializes a record at the end of the file. The serializer is called with a `binary_stream` over the
+   * remaining mapped space and returns true on success. If it fails, the file is extended and it is called again.
+   *
+   * @return false if the record does not fit after extending the file once, or the file cannot be extended.
+   */
+  template<std::endian BufferEndian = std::endian::big, typename Serializer>
+  requires std::invocable<Serializer&, binary_stream<BufferEndian>&>
+  bool append(Serializer&& serializer)
+  {
+    for (bool grown = false;; grown = true) {
+      if (fd_ < 0 || error_ != 0) {
+        return false;
+      }
+      binary_stream<BufferEndian> stream{ bytepack::buffer_view(mapping_ + size_, capacity_ - size_) };
+      if (static_cast<bool>(serializer(stream))) {
+        size_ += stream.data().size();
+        return true;
+      }
+      if (grown || !grow()) {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * @brief Appends already serialized bytes as a record.
+   */
+  bool append(const bytepack::const_buffer_view& record)
+  {
+    if (fd_ < 0 || error_ != 0) {
+      return false;
+    }
+    if (record.size() > capacity_ - size_ && (record.size() > growth_size_ || !grow())) {
+      return false;
+    }
+    if (record.size() > 0) {
+      std::memcpy(mapping_ + size_, record.as<void>(), record.size());
+      size_ += record.size();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Writes the dirty pages of the mapping to the file (`msync`) and waits for completion.
+   */
+  bool sync() noexcept
+  {
+    if (mapping_ != nullptr && ::msync(mapping_, capacity_, MS_SYNC) != 0) {
+      error_ = errno;
+    }
+    return error_ == 0;
+  }
+
+  /**
+   * @brief Unmaps the file, truncates it to the written size and closes it.
+   */
+  bool close() noexcept
+  {
+    if (fd_ < 0) {
+      return error_ == 0;
+    }
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, capacity_);
+      mapping_ = nullptr;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0 && error_ == 0) {
+      error_ = errno;
+    }
+    ::close(fd_);
+    fd_ = -1;
+    return error_ == 0;
+  }
+
+  /**
+   * @brief Returns the number of written bytes.
+   */
+  [[nodiscard]] std::uint64_t size() const noexcept { return size_; }
+
+  /**
+   * @brief Returns the written bytes (valid until the next append or close).
+   */
+  [[nodiscard]] bytepack::buffer_view data() const noexcept { return bytepack::buffer_view(mapping_, size_); }
+
+  [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0 && error_ == 0; }
+
+  [[nodiscard]] int error() const noexcept { return error_; }
+
+private:
+  bool grow() noexcept
+  {
+    const std::size_t capacity = capacity_ + growth_size_;
+    if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+      error_ = errno;
+      return false;
+    }
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    // The old mapping stays valid if mremap fails
+    void* address = mapping_ == nullptr ? ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                                        : ::mremap(mapping_, capacity_, capacity, MREMAP_MAYMOVE);
+#else
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, capacity_);
+      mapping_ = nullptr;
+      capacity_ = 0;
+    }
+    void* address = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+    if (address == MAP_FAILED) {
+      error_ = errno;
+      return false;
+    }
+    mapping_ = static_cast<std::uint8_t*>(address);
+    capacity_ = capacity;
+    return true;
+  }
+
+  int fd_{ -1 };
+  int error_{ 0 };
+  std::size_t growth_size_{ 0 };
+  std::uint8_t* mapping_{ nullptr };
+  std::size_t size_{ 0 };
+  std::size_t capacity_{ 0 };
+};
+
+} // namespace bytepack
+
+#endif // !defined(_WIN32)
+
+#endif // BYTEPACK_MAPPED_FILE_HPP
@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file message_batch.hpp
+ * @brief Optional batching of many small messages for `sendmmsg`/`recvmmsg`, so a single system call sends or
+ * receives dozens of datagrams.
+ *
+ * `message_batch` serializes messages back-to-back into one large (pooled) buffer and records the offset of each
+ * message. On Linux, the messages are exposed as an `mmsghdr`/`iovec` array (one datagram per message) and sent with
+ * `send()`:
+ *
+ *   bytepack::message_batch batch(64 * 1024);
+ *   for (const auto& msg : messages) {
+ *     if (!batch.add([&](auto& stream) { return msg.serialize(stream); })) { break; } // batch is full
+ *   }
+ *   batch.send(socket_fd); // connected socket, or pass the destination address
+ *   batch.clear();
+ *
+ * `receive_batch` (Linux) preallocates fixed-size slots in one buffer and receives up to `max_messages` datagrams
+ * with `recvmmsg`. Each received datagram is accessed as a `buffer_view` and deserialized with `binary_stream`.
+ */
+
+#ifndef BYTEPACK_MESSAGE_BATCH_HPP
+#define BYTEPACK_MESSAGE_BATCH_HPP
+
+#include <cerrno>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#include "aligned_buffer.hpp"
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+/**
+ * @class message_batch
+ * @brief Serializes many messages back-to-back into one buffer, one datagram per message.
+ *
+ * @tparam BufferEndian The endianness to use for serialization. Defaults to big-endian (network byte order).
+ */
+template<std::endian BufferEndian = std::endian::big>
+class message_batch final
+{
+public:
+  explicit message_batch(const std::size_t buffer_size, const page_mode mode = page_mode::default_pages)
+    : storage_{ buffer_size, mode }
+  {}
+
+  /**
+   * @brief Serializes a message at the end of the batch. The serializer is called with a `binary_stream` over the
+   * remaining space and returns true on success.
+   *
+   * @return false if the serializer fails (e.g. the batch is full); the batch is unchanged.
+   */
+  template<typename Serializer>
+  requires std::invocable<Serializer&, binary_stream<BufferEndian>&>
+  bool add(Serializer&& serializer)
+  {
+    const std::size_t offset = offsets_.back();
+    binary_stream<BufferEndian> stream{ bytepack::buffer_view(storage_.data() + offset, storage_.size() - offset) };
+    if (!static_cast<bool>(serializer(stream))) {
+      return false;
+    }
+    offsets_.push_back(offset + stream.data().size());
+    return true;
+  }
+
+  /**
+   * @brief Appends an already serialized message (e.g. a `message_template`).
+   *
+   * @return false if the message exceeds the remaining space.
+   */
+  bool add(const bytepack::const_buffer_view& message)
+  {
+    const std::size_t offset = offsets_.back();
+    if (message.size() > storage_.size() - offset) {
+      return false;
+    }
+    if (message.size() > 0) {
+      std::memcpy(storage_.data() + offset, message.as<void>(), message.size());
+    }
+    offsets_.push_back(offset + message.size());
+    return true;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return offsets_.size() - 1; }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Returns the byte offset of the message at the given index in the batch buffer.
+   */
+  [[nodiscard]] std::size_t offset(const std::size_t index) const noexcept { return offsets_[index]; }
+
+  [[nodiscard]] bytepack::buffer_view message(const std::size_t index) const noexcept
+  {
+    return bytepack::buffer_view(storage_.data() + offsets_[index], offsets_[index + 1] - offsets_[index]);
+  }
+
+  /**
+   * @brief Returns all serialized messages (back-to-back).
+   */
+  [[nodiscard]] bytepack::buffer_view data() const noexcept
+  {
+    return bytepack::buffer_view(storage_.data(), offsets_.back());
+  }
+
+  [[nodiscard]] std::size_t buffer_size() const noexcept { return storage_.size(); }
+
+  /**
+   * @brief Removes all messages. The buffer is reused.
+   */
+  void clear() noexcept { offsets_.resize(1); }
+
+#if defined(__linux__)
+  /**
+   * @brief Returns one `mmsghdr` (with a single `iovec`) per message, for `sendmmsg`. The array is valid until the
+   * batch is modified.
+   *
+   * @param destination Destination address of unconnected sockets, `nullptr` for connected sockets.
+   */
+  [[nodiscard]] std::span<mmsghdr> mmsghdrs(const sockaddr* destination = nullptr,
+                                            const socklen_t destination_length = 0)
+  {
+    // The arrays only grow, so the fields that never change are set once per slot rather than on every send
+    if (headers_.size() < size()) {
+      iovecs_.resize(size());
+      headers_.resize(size());
+      for (std::size_t i = 0; i < headers_.size(); ++i) {
+        headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+        headers_[i].msg_hdr.msg_iovlen = 1;
+      }
+    }
+    for (std::size_t i = 0; i < size(); ++i) {
+      iovecs_[i].iov_base = storage_.data() + offsets_[i];
+      iovecs_[i].iov_len = offsets_[i + 1] - offsets_[i];
+      headers_[i].msg_hdr.msg_name = const_cast<sockaddr*>(destination);
+      headers_[i].msg_hdr.msg_namelen = destination != nullptr ? destination_length : 0;
+    }
+    return std::span<mmsghdr>(headers_.data(), size());
+  }
+
+  /**
+   * @brief Sends all messages with as few `sendmmsg` calls as possible (interrupted calls are retried).
+   *
+   * @return Number of messages sent, or -1 if no message is sent due to an error (`errno` is set).
+   */
+  int send(const int socket, const sockaddr* destination = nullptr, const socklen_t destination_length = 0,
+           const int flags = 0)
+  {
+    const std::span<mmsghdr> headers = mmsghdrs(destination, destination_length);
+    std::size_t sent = 0;
+    while (sent < headers.size()) {
+      const std::size_t count = std::min<std::size_t>(headers.size() - sent, max_messages_per_call);
+      const int result = ::sendmmsg(socket, headers.data() + sent, static_cast<unsigned int>(count), flags);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return sent > 0 ? static_cast<int>(sent) : -1;
+      }
+      sent += static_cast<std::size_t>(result);
+    }
+    return static_cast<int>(sent);
+  }
+#endif
+
+private:
+  // Maximum number of messages per `sendmmsg` call (UIO_MAXIOV)
+  static constexpr std::size_t max_messages_per_call = 1024;
+
+  aligned_buffer storage_;
+  std::vector<std::size_t> offsets_{ 0 }; // offsets_[i] is the start of the i-th message, size() + 1 entries
+#if defined(__linux__)
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> headers_;
+#endif
+};
+
+#if defined(__linux__)
+/**
+ * @class receive_batch
+ * @brief Receives up to `max_messages` datagrams with a single `recvmmsg` call into preallocated slots of one buffer.
+ */
+class receive_batch final
+{
+public:
+  /**
+   * @param max_message_size Size of each slot. Larger datagrams are truncated (see `truncated()`).
+   */
+  receive_batch(const std::size_t max_messages, const std::size_t max_message_size,
+                const page_mode mode = page_mode::default_pages)
+    : max_messages_{ max_messages }, max_message_size_{ max_message_size },
+      slot_size_{ (max_message_size + aligned_buffer::alignment - 1) / aligned_buffer::alignment
+                  * aligned_buffer::alignment },
+      storage_{ max_messages * slot_size_, mode }, iovecs_(max_messages), headers_(max_messages),
+      sources_(max_messages)
+  {
+    for (std::size_t i = 0; i < max_messages_; ++i) {
+      iovecs_[i].iov_base = storage_.data() + i * slot_size_;
+      iovecs_[i].iov_len = max_message_size_;
+      headers_[i].msg_hdr.msg_name = &sources_[i];
+      headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+      headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+      headers_[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+
+  /**
+   * @brief Receives datagrams with `recvmmsg` (interrupted calls are retried). By default, it blocks until at least
+   * one datagram is available and then receives the pending ones without blocking (`MSG_WAITFORONE`).
+   *
+   * @return Number of received datagrams, or -1 on error (`errno` is set).
+   */
+  int receive(const int socket, const int flags = MSG_WAITFORONE, timespec* timeout = nullptr)
+  {
+    // Only the address lengths of the previously received datagrams were overwritten by the kernel
+    for (std::size_t i = 0; i < received_; ++i) {
+      headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+
+    int result = 0;
+    do {
+      result = ::recvmmsg(socket, headers_.data(), static_cast<unsigned int>(max_messages_), flags, timeout);
+    } while (result < 0 && errno == EINTR);
+
+    received_ = result > 0 ? static_cast<std::size_t>(result) : 0;
+    return result;
+  }
+
+  /**
+   * @brief Returns the number of datagrams received by the last `receive()`.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return received_; }
+
+  [[nodiscard]] bool empty() const noexcept { return received_ == 0; }
+
+  [[nodiscard]] bytepack::buffer_view message(const std::size_t index) const noexcept
+  {
+    return bytepack::buffer_view(storage_.data() + index * slot_size_, headers_[index].msg_len);
+  }
+
+  /**
+   * @brief Returns true if the datagram was larger than `max_message_size` and was truncated.
+   */
+  [[nodiscard]] bool truncated(const std::size_t index) const noexcept
+  {
+    return (headers_[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+  }
+
+  /**
+   * @brief Returns the source address of the datagram.
+   */
+  [[nodiscard]] const sockaddr_storage& source(const std::size_t index) const noexcept { return sources_[index]; }
+
+  [[nodiscard]] std::size_t max_messages() const noexcept { return max_messages_; }
+
+  [[nodiscard]] std::size_t max_message_size() const noexcept { return max_message_size_; }
+
+private:
+  std::size_t max_messages_;
+  std::size_t max_message_size_;
+  std::size_t slot_size_; // max_message_size rounded up to the cache line size
+  aligned_buffer storage_;
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> headers_;
+  std::vector<sockaddr_storage> sources_;
+  std::size_t received_{ 0 };
+};
+#endif
+
+} // namespace bytepack
+
+#endif // BYTEPACK_MESSAGE_BATCH_HPP
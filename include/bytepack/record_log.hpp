@@ -0,0 +1,488 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file record_log.hpp
+ * @brief Optional indexed record log (POSIX): an append-only segment file of timestamped, length-prefixed records
+ * with a sparse index footer, for random access to record #N or to a time range of multi-gigabyte capture files
+ * without scanning them.
+ *
+ *   bytepack::record_log_writer writer("capture.0.bplog");
+ *   writer.append(timestamp, [&](auto& stream) { return msg.serialize(stream); });
+ *   writer.close(); // writes the index footer (or destructor)
+ *
+ *   bytepack::record_log_reader reader("capture.0.bplog");
+ *   bytepack::log_record record{};
+ *   reader.seek(1'000'000); // or reader.seek_time(start)
+ *   while (reader.next(record)) {
+ *     bytepack::binary_reader stream(record.data);
+ *     msg.deserialize(stream);
+ *   }
+ *
+ * Segment format (integers in the `BufferEndian` byte order of the writer and reader):
+ * - Header (16 bytes): magic `BPLG`, version (uint16), reserved (uint16), number of the first record (uint64). Record
+ *   numbers of consecutive segments continue with `record_log_options::first_record`.
+ * - Records: payload size (uint32), timestamp (uint64), payload.
+ * - Index: one entry for every `index_interval`-th record: record number, timestamp, file offset (uint64 each).
+ * - Trailer (24 bytes): record count (uint64), index offset (uint64), index interval (uint32), magic `BPIX`.
+ *
+ * Timestamps must be non-decreasing for `seek_time`. A segment that was not closed has no footer and is rejected by
+ * the reader.
+ */
+
+#ifndef BYTEPACK_RECORD_LOG_HPP
+#define BYTEPACK_RECORD_LOG_HPP
+
+#if !defined(_WIN32)
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "bytepack.hpp"
+#include "mapped_file.hpp"
+
+namespace bytepack {
+
+struct record_log_options
+{
+  std::uint32_t index_interval = 64;          // an index entry every N records
+  std::uint64_t first_record = 0;             // number of the first record of the segment
+  std::size_t growth_size = 64 * 1024 * 1024; // file growth step, also the maximum record size
+};
+
+/**
+ * @brief A record returned by record_log_reader. `data` points into the mapped file and is valid until the next call
+ * of the reader.
+ */
+struct log_record
+{
+  std::uint64_t number{};
+  std::uint64_t timestamp{};
+  bytepack::const_buffer_view data{ static_cast<const void*>(nullptr), 0 };
+};
+
+namespace detail {
+
+inline constexpr std::uint32_t record_log_magic = 0x42504C47;   // "BPLG"
+inline constexpr std::uint32_t record_index_magic = 0x42504958; // "BPIX"
+inline constexpr std::uint16_t record_log_version = 1;
+inline constexpr std::size_t record_log_header_size = 16;
+inline constexpr std::size_t record_log_trailer_size = 24;
+inline constexpr std::size_t record_header_size = 12;
+inline constexpr std::size_t record_index_entry_size = 24;
+
+struct record_index_entry
+{
+  std::uint64_t number;
+  std::uint64_t timestamp;
+  std::uint64_t offset;
+};
+
+} // namespace detail
+
+/**
+ * @class record_log_writer
+ * @brief Appends timestamped records to a segment file (see the file description). Records are serialized directly
+ * into the memory-mapped file (`mapped_file_writer`).
+ */
+template<std::endian BufferEndian = std::endian::big>
+class record_log_writer final
+{
+public:
+  explicit record_log_writer(const char* path, const record_log_options& options = {}) noexcept
+    : file_{ path, options.growth_size }, growth_size_{ options.growth_size },
+      index_interval_{ std::max<std::uint32_t>(options.index_interval, 1) }, first_record_{ options.first_record }
+  {
+    static_cast<void>(file_.template append<BufferEndian>([&](binary_stream<BufferEndian>& stream) {
+      return stream.write(detail::record_log_magic, detail::record_log_version, std::uint16_t{ 0 }, first_record_);
+    }));
+  }
+
+  ~record_log_writer() noexcept { static_cast<void>(close()); }
+
+  record_log_writer(const record_log_writer&) = delete;
+  record_log_writer& operator=(const record_log_writer&) = delete;
+  record_log_writer(record_log_writer&&) = delete;
+  record_log_writer& operator=(record_log_writer&&) = delete;
+
+  /**
+   * @brief Serializes a record. The serializer is called with a `binary_stream` positioned after the record header
+   * and returns true on success; the payload size is filled in afterwards.
+   *
+   * @return false if the serializer fails, the record is larger than the growth size, or the file cannot be extended.
+   */
+  template<typename Serializer>
+  requires std::invocable<Serializer&, binary_stream<BufferEndian>&>
+  bool append(const std::uint64_t timestamp, Serializer&& serializer)
+  {
+    if (closed_) {
+      return false;
+    }
+    const std::uint64_t offset = file_.size();
+    const bool appended = file_.template append<BufferEndian>([&](binary_stream<BufferEndian>& stream) {
+      if (!stream.write(std::uint32_t{ 0 }, timestamp) || !static_cast<bool>(serializer(stream))) {
+        return false;
+      }
+      const std::size_t payload_size = stream.data().size() - detail::record_header_size;
+      return payload_size <= std::numeric_limits<std::uint32_t>::max()
+             && stream.template write_field<0>(static_cast<std::uint32_t>(payload_size));
+    });
+    if (appended) {
+      add_to_index(timestamp, offset);
+    }
+    return appended;
+  }
+
+  /**
+   * @brief Appends already serialized bytes as the payload of a record.
+   */
+  bool append(const std::uint64_t timestamp, const bytepack::const_buffer_view& payload)
+  {
+    if (closed_ || payload.size() + detail::record_header_size > growth_size_) {
+      return false;
+    }
+    const std::uint64_t offset = file_.size();
+    const bool appended = file_.template append<BufferEndian>([&](binary_stream<BufferEndian>& stream) {
+      return stream.write(static_cast<std::uint32_t>(payload.size()), timestamp);
+    }) && file_.append(payload);
+    if (appended) {
+      add_to_index(timestamp, offset);
+    }
+    return appended;
+  }
+
+  /**
+   * @brief Writes the index footer and closes the file. No records can be appended afterwards.
+   *
+   * @return false if writing the file failed (see `error()`).
+   */
+  bool close() noexcept
+  {
+    if (closed_) {
+      return file_.error() == 0;
+    }
+    closed_ = true;
+    const std::uint64_t index_offset = file_.size();
+    bool written = true;
+    for (const auto& entry : index_) {
+      written = written && file_.template append<BufferEndian>([&](binary_stream<BufferEndian>& stream) {
+        return stream.write(entry.number, entry.timestamp, entry.offset);
+      });
+    }
+    written = written && file_.template append<BufferEndian>([&](binary_stream<BufferEndian>& stream) {
+      return stream.write(record_count_, index_offset, index_interval_, detail::record_index_magic);
+    });
+    return file_.close() && written;
+  }
+
+  /**
+   * @brief Returns the number of records appended to the segment.
+   */
+  [[nodiscard]] std::uint64_t record_count() const noexcept { return record_count_; }
+
+  [[nodiscard]] bool is_open() const noexcept { return !closed_ && file_.is_open(); }
+
+  /**
+   * @brief Returns the `errno` value of a failed file operation, 0 if there is no error.
+   */
+  [[nodiscard]] int error() const noexcept { return file_.error(); }
+
+private:
+  void add_to_index(const std::uint64_t timestamp, const std::uint64_t offset)
+  {
+    if (record_count_ % index_interval_ == 0) {
+      index_.push_back(detail::record_index_entry{ first_record_ + record_count_, timestamp, offset });
+    }
+    ++record_count_;
+  }
+
+  mapped_file_writer file_;
+  std::size_t growth_size_;
+  std::uint32_t index_interval_;
+  std::uint64_t first_record_;
+  std::uint64_t record_count_{ 0 };
+  std::vector<detail::record_index_entry> index_;
+  bool closed_{ false };
+};
+
+/**
+ * @class record_log_reader
+ * @brief Reads records of a closed segment file sequentially from any record number or timestamp. The header and
+ * trailer are validated on open; the index is loaded on the first seek.
+ */
+template<std::endian BufferEndian = std::endian::big>
+class record_log_reader final
+{
+public:
+  /**
+   * @param window_size Maximum size of the file mapping, 0 maps the whole file (see mapped_file_reader).
+   */
+  explicit record_log_reader(const char* path, const std::size_t window_size = 0) noexcept
+    : file_{ path, window_size }
+  {
+    if (file_.error() != 0) {
+      return;
+    }
+    const std::uint64_t file_size = file_.file_size();
+    std::uint32_t magic{};
+    std::uint16_t version{};
+    std::uint16_t reserved{};
+    if (file_size < detail::record_log_header_size + detail::record_log_trailer_size
+        || !read_at(0, detail::record_log_header_size, magic, version, reserved, first_record_)
+        || magic != detail::record_log_magic || version != detail::record_log_version) {
+      error_ = EINVAL;
+      return;
+    }
+
+    std::uint32_t index_magic{};
+    const std::uint64_t trailer_offset = file_size - detail::record_log_trailer_size;
+    if (!read_at(trailer_offset, detail::record_log_trailer_size, record_count_, index_offset_, index_interval_,
+                 index_magic)
+        || index_magic != detail::record_index_magic || index_interval_ == 0
+        || index_offset_ < detail::record_log_header_size || index_offset_ > trailer_offset
+        || (trailer_offset - index_offset_) % detail::record_index_entry_size != 0) {
+      error_ = EINVAL;
+      return;
+    }
+    index_size_ = (trailer_offset - index_offset_) / detail::record_index_entry_size;
+    // One index entry per started interval (checked here so that an empty index never reaches seek())
+    if (index_size_ != record_count_ / index_interval_ + (record_count_ % index_interval_ != 0 ? 1 : 0)) {
+      error_ = EINVAL;
+      return;
+    }
+    position_ = detail::record_log_header_size;
+    next_record_ = first_record_;
+  }
+
+  record_log_reader(const record_log_reader&) = delete;
+  record_log_reader& operator=(const record_log_reader&) = delete;
+  record_log_reader(record_log_reader&&) = delete;
+  record_log_reader& operator=(record_log_reader&&) = delete;
+
+  /**
+   * @brief Positions the reader at the given record number: one index lookup and a scan of at most
+   * `index_interval - 1` record headers.
+   *
+   * @return false if the record is not in the segment, or the file is invalid.
+   */
+  bool seek(const std::uint64_t number)
+  {
+    if (!load_index() || number < first_record_ || number - first_record_ >= record_count_) {
+      return false;
+    }
+    const auto& entry = index_[static_cast<std::size_t>((number - first_record_) / index_interval_)];
+    position_ = entry.offset;
+    next_record_ = entry.number;
+    while (next_record_ < number) {
+      if (!skip()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Positions the reader at the first record whose timestamp is greater than or equal to the given timestamp
+   * (binary search in the index, then a scan of record headers).
+   *
+   * @return false if there is no such record (the reader is positioned at the end), or the file is invalid.
+   */
+  bool seek_time(const std::uint64_t timestamp)
+  {
+    if (!load_index()) {
+      return false;
+    }
+    const auto entry = std::partition_point(index_.begin(), index_.end(),
+                                            [&](const auto& e) { return e.timestamp < timestamp; });
+    if (entry == index_.begin()) {
+      position_ = detail::record_log_header_size;
+      next_record_ = first_record_;
+    } else {
+      position_ = std::prev(entry)->offset;
+      next_record_ = std::prev(entry)->number;
+    }
+
+    std::uint64_t record_timestamp{};
+    while (peek_timestamp(record_timestamp)) {
+      if (record_timestamp >= timestamp) {
+        return true;
+      }
+      if (!skip()) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Reads the record at the current position and advances to the next one.
+   *
+   * @return false at the end of the segment, or if the record is invalid or larger than the mapping window (see
+   * `error()`).
+   */
+  bool next(log_record& record)
+  {
+    std::uint32_t size{};
+    std::uint64_t timestamp{};
+    if (!read_header(size, timestamp) || !file_mapped(position_, detail::record_header_size + size)) {
+      return false;
+    }
+    record.number = next_record_;
+    record.timestamp = timestamp;
+    record.data = bytepack::const_buffer_view(mapped(position_ + detail::record_header_size), size);
+    position_ += detail::record_header_size + size;
+    ++next_record_;
+    return true;
+  }
+
+  /**
+   * @brief Calls the visitor for each record with a timestamp in [begin, end). The visitor returns true to continue.
+   *
+   * @return false if the visitor stops or a record is invalid.
+   */
+  template<typename Visitor>
+  requires std::invocable<Visitor&, const log_record&>
+  bool for_each_in_time_range(const std::uint64_t begin, const std::uint64_t end, Visitor&& visitor)
+  {
+    if (!seek_time(begin)) {
+      return error_ == 0;
+    }
+    log_record record{};
+    while (next(record) && record.timestamp < end) {
+      if (!static_cast<bool>(visitor(record))) {
+        return false;
+      }
+    }
+    return error_ == 0;
+  }
+
+  /**
+   * @brief Returns the number of the record that is read by the next `next()` call.
+   */
+  [[nodiscard]] std::uint64_t position() const noexcept { return next_record_; }
+
+  [[nodiscard]] std::uint64_t first_record() const noexcept { return first_record_; }
+
+  [[nodiscard]] std::uint64_t record_count() const noexcept { return record_count_; }
+
+  [[nodiscard]] bool is_open() const noexcept { return error() == 0; }
+
+  /**
+   * @brief Returns the `errno` value of a failed file operation, or `EINVAL` for an invalid segment file.
+   */
+  [[nodiscard]] int error() const noexcept { return error_ != 0 ? error_ : file_.error(); }
+
+private:
+  // Maps the window at the offset if [offset, offset + size) is not mapped
+  bool file_mapped(const std::uint64_t offset, const std::size_t size) noexcept
+  {
+    if (offset < file_.offset() || offset + size > file_.offset() + file_.view().size()) {
+      if (!file_.map(offset) || size > file_.view().size()) {
+        if (error() == 0) {
+          error_ = EFBIG; // larger than the window
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const std::uint8_t* mapped(const std::uint64_t offset) const noexcept
+  {
+    return file_.view().as<std::uint8_t>() + (offset - file_.offset());
+  }
+
+  template<typename... Ts>
+  bool read_at(const std::uint64_t offset, const std::size_t size, Ts&... values) noexcept
+  {
+    if (!file_mapped(offset, size)) {
+      return false;
+    }
+    binary_reader<BufferEndian> stream{ bytepack::const_buffer_view(mapped(offset), size) };
+    return stream.read(values...);
+  }
+
+  bool load_index()
+  {
+    if (error() != 0) {
+      return false;
+    }
+    if (index_.size() == index_size_) {
+      return true;
+    }
+    index_.resize(static_cast<std::size_t>(index_size_));
+    for (std::size_t i = 0; i < index_.size(); ++i) {
+      auto& entry = index_[i];
+      if (!read_at(index_offset_ + i * detail::record_index_entry_size, detail::record_index_entry_size, entry.number,
+                   entry.timestamp, entry.offset)
+          || entry.number != first_record_ + i * index_interval_ || entry.offset < detail::record_log_header_size
+          || entry.offset >= index_offset_) {
+        index_.clear();
+        error_ = EINVAL;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Reads the header of the record at the current position (false at the end of the records)
+  bool read_header(std::uint32_t& size, std::uint64_t& timestamp) noexcept
+  {
+    if (error() != 0 || position_ >= index_offset_) {
+      return false;
+    }
+    if (index_offset_ - position_ < detail::record_header_size
+        || !read_at(position_, detail::record_header_size, size, timestamp)
+        || size > index_offset_ - position_ - detail::record_header_size) {
+      error_ = EINVAL;
+      return false;
+    }
+    return true;
+  }
+
+  bool peek_timestamp(std::uint64_t& timestamp) noexcept
+  {
+    std::uint32_t size{};
+    return read_header(size, timestamp);
+  }
+
+  bool skip() noexcept
+  {
+    std::uint32_t size{};
+    std::uint64_t timestamp{};
+    if (!read_header(size, timestamp)) {
+      return false;
+    }
+    position_ += detail::record_header_size + size;
+    ++next_record_;
+    return true;
+  }
+
+  mapped_file_reader file_;
+  int error_{ 0 };
+  std::uint64_t first_record_{ 0 };
+  std::uint64_t record_count_{ 0 };
+  std::uint64_t index_offset_{ 0 };
+  std::uint32_t index_interval_{ 0 };
+  std::uint64_t index_size_{ 0 };
+  std::vector<detail::record_index_entry> index_;
+  std::uint64_t position_{ 0 };    // file offset of the next record
+  std::uint64_t next_record_{ 0 }; // number of the next record
+};
+
+} // namespace bytepack
+
+#endif // !defined(_WIN32)
+
+#endif // BYTEPACK_RECORD_LOG_HPP
@@ -0,0 +1,435 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file resumable_stream.hpp
+ * @brief Optional C++20 coroutine-based decoder for incremental input (e.g. TCP reads). Deserialization is written
+ * linearly with `co_await stream.read(value)`; if the received bytes are insufficient, the coroutine suspends and
+ * resumes exactly where it left off when more bytes are fed. Nothing is parsed twice and the message is not buffered:
+ * bytes are copied directly into the values (a value that spans two chunks is completed when the next chunk arrives).
+ *
+ *   bytepack::decode_task decode(bytepack::resumable_stream<>& stream, Message& msg)
+ *   {
+ *     co_await stream.read(msg.id);
+ *     co_await stream.read(msg.name);   // std::uint32_t length prefix by default, like binary_stream
+ *     co_await stream.read(msg.values);
+ *   }
+ *
+ *   bytepack::resumable_stream stream;
+ *   auto task = decode(stream, msg); // runs until the first read that needs data
+ *   while (!task.done()) {
+ *     const auto size = ::recv(socket, chunk, sizeof(chunk), 0);
+ *     stream.feed(bytepack::buffer_view(chunk, size)); // resumes the coroutine
+ *   }
+ *
+ * The wire format is the same as `binary_stream<BufferEndian>`. A read resumes with `false` on failure (e.g. a length
+ * prefix above the limit, or `close()`); after the first failure, all reads fail (see `error()`).
+ */
+
+#ifndef BYTEPACK_RESUMABLE_STREAM_HPP
+#define BYTEPACK_RESUMABLE_STREAM_HPP
+
+#include <coroutine>
+#include <exception>
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+/**
+ * @class decode_task
+ * @brief Coroutine type of decoders that read from a resumable_stream. The coroutine starts immediately and runs
+ * until it needs more data; `done()` returns true when it has finished.
+ *
+ * Decoders can be nested: `co_await decode_header(stream, msg.header);` continues when the nested decoder finishes.
+ */
+class decode_task final
+{
+public:
+  struct promise_type
+  {
+    struct final_awaiter
+    {
+      bool await_ready() const noexcept { return false; }
+
+      // Continues the awaiting decoder, if any
+      std::coroutine_handle<> await_suspend(const std::coroutine_handle<promise_type> handle) const noexcept
+      {
+        const std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    decode_task get_return_object() noexcept
+    {
+      return decode_task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    std::coroutine_handle<> continuation{ nullptr };
+  };
+
+  struct awaiter
+  {
+    std::coroutine_handle<promise_type> handle;
+
+    bool await_ready() const noexcept { return handle == nullptr || handle.done(); }
+
+    void await_suspend(const std::coroutine_handle<> continuation) const noexcept
+    {
+      handle.promise().continuation = continuation;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  decode_task(decode_task&& other) noexcept : handle_{ std::exchange(other.handle_, nullptr) } {}
+
+  decode_task& operator=(decode_task&& other) noexcept
+  {
+    if (this != &other) {
+      destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  decode_task(const decode_task&) = delete;
+  decode_task& operator=(const decode_task&) = delete;
+
+  ~decode_task() noexcept { destroy(); }
+
+  [[nodiscard]] bool done() const noexcept { return handle_ == nullptr || handle_.done(); }
+
+  awaiter operator co_await() const& noexcept { return awaiter{ handle_ }; }
+
+private:
+  explicit decode_task(const std::coroutine_handle<promise_type> handle) noexcept : handle_{ handle } {}
+
+  void destroy() noexcept
+  {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @class resumable_stream
+ * @brief Input stream of coroutine decoders (see the file description). One coroutine reads from the stream at a
+ * time.
+ *
+ * @tparam BufferEndian The endianness of the serialized data. Defaults to big-endian (network byte order).
+ */
+template<std::endian BufferEndian = std::endian::big>
+class resumable_stream final
+{
+  // Awaitable of a single read. `Operation::advance(stream)` consumes the available bytes and returns true when the
+  // read is completed (or failed).
+  template<typename Operation>
+  class awaitable
+  {
+  public:
+    awaitable(resumable_stream& stream, const Operation& operation) noexcept
+      : stream_{ stream }, operation_{ operation }
+    {}
+
+    // The awaitable lives in the coroutine frame while the read is suspended. If the frame is destroyed first (its
+    // decode_task is destroyed), the stream must not resume it.
+    ~awaitable()
+    {
+      if (stream_.pending_ == &operation_) {
+        stream_.waiting_ = nullptr;
+        stream_.pending_ = nullptr;
+      }
+    }
+
+    awaitable(const awaitable&) = delete;
+    awaitable& operator=(const awaitable&) = delete;
+
+    bool await_ready() noexcept
+    {
+      stream_.field_offset_ = stream_.offset();
+      return stream_.failed() || operation_.advance(stream_);
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle) noexcept
+    {
+      stream_.waiting_ = handle;
+      stream_.pending_ = &operation_;
+      stream_.advance_pending_ = [](void* operation, resumable_stream& stream) noexcept {
+        return static_cast<Operation*>(operation)->advance(stream);
+      };
+    }
+
+    [[nodiscard]] bool await_resume() const noexcept { return !stream_.failed(); }
+
+  private:
+    resumable_stream& stream_;
+    Operation operation_;
+  };
+
+public:
+  /**
+   * @param max_length Maximum number of elements of length-prefixed strings and vectors. The destination is resized
+   *                   before its data arrives, so the limit protects against huge allocations from corrupt prefixes.
+   */
+  explicit resumable_stream(const std::size_t max_length = 64 * 1024 * 1024) noexcept : max_length_{ max_length } {}
+
+  resumable_stream(const resumable_stream&) = delete;
+  resumable_stream& operator=(const resumable_stream&) = delete;
+  resumable_stream(resumable_stream&&) = delete;
+  resumable_stream& operator=(resumable_stream&&) = delete;
+
+  /**
+   * @brief Consumes a chunk of input and resumes the waiting coroutine. The chunk is only accessed during the call.
+   *
+   * @return Number of consumed bytes. It is less than the chunk size if the coroutine finished (or stopped reading)
+   * before the end of the chunk; the remaining bytes can be fed to the next decoder.
+   */
+  std::size_t feed(const bytepack::const_buffer_view& chunk) noexcept
+  {
+    data_ = chunk.as<const std::uint8_t>();
+    size_ = chunk.size();
+    index_ = 0;
+
+    if (waiting_ && (failed() || advance_pending_(pending_, *this))) {
+      resume();
+    }
+
+    const std::size_t consumed = index_;
+    offset_ += consumed;
+    data_ = nullptr;
+    size_ = 0;
+    index_ = 0;
+    return consumed;
+  }
+
+  /**
+   * @brief Ends the input: the waiting read fails with `error_code::buffer_overflow` and the coroutine is resumed.
+   */
+  void close() noexcept
+  {
+    if (waiting_) {
+      fail(error_code::buffer_overflow);
+      resume();
+    }
+  }
+
+  /**
+   * @brief Returns true if a coroutine is suspended in a read, waiting for more data.
+   */
+  [[nodiscard]] bool waiting() const noexcept { return static_cast<bool>(waiting_); }
+
+  [[nodiscard]] stream_error error() const noexcept { return error_; }
+
+  /**
+   * @brief Returns the total number of consumed bytes.
+   */
+  [[nodiscard]] std::size_t offset() const noexcept { return offset_ + index_; }
+
+  /**
+   * @brief Clears the error state and abandons the waiting coroutine, if any. A coroutine whose decode_task is
+   * destroyed while it waits is abandoned automatically.
+   */
+  void reset() noexcept
+  {
+    waiting_ = nullptr;
+    pending_ = nullptr;
+    error_ = stream_error{};
+  }
+
+  template<NetworkSerializableBasic T>
+  [[nodiscard]] auto read(T& value) noexcept
+  {
+    return awaitable<elements_read<T>>{ *this, elements_read<T>{ &value, 1 } };
+  }
+
+  template<NetworkSerializableBasic T, std::size_t N>
+  [[nodiscard]] auto read(T (&array)[N]) noexcept
+  {
+    return awaitable<elements_read<T>>{ *this, elements_read<T>{ array, N } };
+  }
+
+  template<NetworkSerializableBasic T, std::size_t N>
+  [[nodiscard]] auto read(std::array<T, N>& array) noexcept
+  {
+    return awaitable<elements_read<T>>{ *this, elements_read<T>{ array.data(), N } };
+  }
+
+  template<IntegralType SizeType = std::uint32_t, NetworkSerializableBasic T>
+  requires(std::is_same_v<T, bool> == false)
+  [[nodiscard]] auto read(std::vector<T>& vector) noexcept
+  {
+    using operation = prefixed_read<SizeType, std::vector<T>>;
+    return awaitable<operation>{ *this, operation{ &vector } };
+  }
+
+  template<std::size_t N, NetworkSerializableBasic T>
+  requires(std::is_same_v<T, bool> == false)
+  [[nodiscard]] auto read(std::vector<T>& vector) noexcept
+  {
+    vector.resize(N);
+    return awaitable<elements_read<T>>{ *this, elements_read<T>{ vector.data(), N } };
+  }
+
+  template<IntegralType SizeType = std::uint32_t>
+  [[nodiscard]] auto read(std::string& value) noexcept
+  {
+    using operation = prefixed_read<SizeType, std::string>;
+    return awaitable<operation>{ *this, operation{ &value } };
+  }
+
+  /**
+   * @brief Reads a fixed-length string; it is truncated at the first null character, like `binary_stream`.
+   */
+  template<std::size_t N>
+  [[nodiscard]] auto read(std::string& value) noexcept
+  {
+    value.resize(N);
+    return awaitable<fixed_string_read>{ *this, fixed_string_read{ &value } };
+  }
+
+private:
+  template<NetworkSerializableBasic T>
+  struct elements_read
+  {
+    T* elements;
+    std::size_t count;
+    std::size_t copied{ 0 };
+
+    bool advance(resumable_stream& stream) noexcept
+    {
+      if (!stream.copy(reinterpret_cast<std::uint8_t*>(elements), count * sizeof(T), copied)) {
+        return false;
+      }
+      to_native(elements, count);
+      return true;
+    }
+  };
+
+  template<IntegralType SizeType, typename Container>
+  struct prefixed_read
+  {
+    Container* container;
+    std::array<std::uint8_t, sizeof(SizeType)> prefix{};
+    std::size_t prefix_copied{ 0 };
+    bool has_size{ false };
+    std::size_t copied{ 0 };
+
+    bool advance(resumable_stream& stream) noexcept
+    {
+      using T = typename Container::value_type;
+      if (!has_size) {
+        if (!stream.copy(prefix.data(), prefix.size(), prefix_copied)) {
+          return false;
+        }
+        SizeType size{};
+        std::size_t index = 0;
+        detail::unpack_element<BufferEndian>(prefix.data(), index, size);
+        if (size < 0 || static_cast<std::uintmax_t>(size) > stream.max_length_) {
+          stream.fail(error_code::invalid_size);
+          return true;
+        }
+        container->resize(static_cast<std::size_t>(size));
+        has_size = true;
+      }
+      if (!stream.copy(reinterpret_cast<std::uint8_t*>(container->data()), container->size() * sizeof(T), copied)) {
+        return false;
+      }
+      to_native(container->data(), container->size());
+      return true;
+    }
+  };
+
+  struct fixed_string_read
+  {
+    std::string* value;
+    std::size_t copied{ 0 };
+
+    bool advance(resumable_stream& stream) noexcept
+    {
+      if (!stream.copy(reinterpret_cast<std::uint8_t*>(value->data()), value->size(), copied)) {
+        return false;
+      }
+      if (const std::size_t null_pos = value->find('\0'); null_pos != std::string::npos) {
+        value->resize(null_pos);
+      }
+      return true;
+    }
+  };
+
+  // Copies the available bytes of the current chunk; returns true when `size` bytes are copied in total
+  bool copy(std::uint8_t* destination, const std::size_t size, std::size_t& copied) noexcept
+  {
+    const std::size_t count = std::min(size - copied, size_ - index_);
+    if (count > 0) {
+      std::memcpy(destination + copied, data_ + index_, count);
+      copied += count;
+      index_ += count;
+    }
+    return copied == size;
+  }
+
+  template<NetworkSerializableBasic T>
+  static void to_native([[maybe_unused]] T* elements, [[maybe_unused]] const std::size_t count) noexcept
+  {
+    if constexpr (BufferEndian != std::endian::native && sizeof(T) > 1) {
+      auto* bytes = reinterpret_cast<std::uint8_t*>(elements);
+      for (std::size_t i = 0; i < count; ++i) {
+        std::reverse(bytes + i * sizeof(T), bytes + (i + 1) * sizeof(T));
+      }
+    }
+  }
+
+  [[nodiscard]] bool failed() const noexcept { return error_.code != error_code::success; }
+
+  void fail(const error_code code) noexcept
+  {
+    if (!failed()) {
+      error_ = stream_error{ code, field_offset_ };
+    }
+  }
+
+  void resume() noexcept
+  {
+    pending_ = nullptr;
+    std::exchange(waiting_, nullptr).resume();
+  }
+
+  std::size_t max_length_;
+  const std::uint8_t* data_{ nullptr };
+  std::size_t size_{ 0 };
+  std::size_t index_{ 0 };
+  std::size_t offset_{ 0 };
+  std::size_t field_offset_{ 0 }; // offset of the current read
+  stream_error error_{};
+  std::coroutine_handle<> waiting_{ nullptr };
+  void* pending_{ nullptr };
+  bool (*advance_pending_)(void*, resumable_stream&) noexcept { nullptr };
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_RESUMABLE_STREAM_HPP
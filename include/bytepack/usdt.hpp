@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file usdt.hpp
+ * @brief Optional USDT (user-level statically defined tracing) probes for binary_stream, as an instrumentation policy.
+ * Probes can be attached in live processes with `perf`, `bpftrace`, SystemTap, etc. without rebuilding. A probe that
+ * is not attached is a single `nop` instruction.
+ *
+ * Probes are compiled in only if `<sys/sdt.h>` is available (e.g. `systemtap-sdt-dev` / `systemtap-sdt-devel`
+ * package on Linux) and `BYTEPACK_DISABLE_USDT` is not defined. Otherwise `usdt_probes::enabled` is false and the
+ * policy is compiled out like `no_instrumentation`.
+ *
+ * Probes (provider `bytepack`):
+ * - `message_begin(buffer_size)`: stream construction and `reset()`
+ * - `message_end(bytes_written, bytes_read, buffer_size)`: `reset()` and stream destruction
+ * - `failure(error_code, offset, function)`: failed read/write, `function` is the signature of the failing function
+ * - `bulk_write(offset, size)` and `bulk_read(offset, size)`: array, vector and string data copies
+ *
+ * Usage:
+ *   bytepack::binary_stream<std::endian::big, bytepack::usdt_probes> stream(1024);
+ *   bpftrace -e 'usdt:./app:bytepack:message_end { @size = hist(arg0); }'
+ */
+
+#ifndef BYTEPACK_USDT_HPP
+#define BYTEPACK_USDT_HPP
+
+#if defined(__has_include) && !defined(BYTEPACK_DISABLE_USDT)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#endif
+#endif
+
+#include "bytepack.hpp"
+
+namespace bytepack {
+
+namespace detail {
+
+#if defined(DTRACE_PROBE3) && !defined(BYTEPACK_DISABLE_USDT)
+
+inline constexpr bool usdt_available = true;
+
+inline void usdt_message_begin(const std::size_t buffer_size) noexcept
+{
+  DTRACE_PROBE1(bytepack, message_begin, buffer_size);
+}
+
+inline void usdt_message_end(const std::size_t written, const std::size_t read, const std::size_t buffer_size) noexcept
+{
+  DTRACE_PROBE3(bytepack, message_end, written, read, buffer_size);
+}
+
+inline void usdt_failure(const error_code code, const std::size_t offset, const char* function) noexcept
+{
+  DTRACE_PROBE3(bytepack, failure, static_cast<unsigned>(code), offset, function);
+}
+
+inline void usdt_bulk_copy(const bool is_write, const std::size_t offset, const std::size_t size) noexcept
+{
+  if (is_write) {
+    DTRACE_PROBE2(bytepack, bulk_write, offset, size);
+  } else {
+    DTRACE_PROBE2(bytepack, bulk_read, offset, size);
+  }
+}
+
+#else
+
+inline constexpr bool usdt_available = false;
+
+inline void usdt_message_begin(const std::size_t) noexcept {}
+
+inline void usdt_message_end(const std::size_t, const std::size_t, const std::size_t) noexcept {}
+
+inline void usdt_failure(const error_code, const std::size_t, const char*) noexcept {}
+
+inline void usdt_bulk_copy(const bool, const std::size_t, const std::size_t) noexcept {}
+
+#endif
+
+} // namespace detail
+
+/**
+ * @struct usdt_probes
+ * @brief Instrumentation policy of binary_stream that fires USDT probes (see the file description).
+ */
+struct usdt_probes
+{
+  static constexpr bool enabled = detail::usdt_available;
+
+  struct stream_state
+  {};
+
+  static void on_begin(const stream_state&, const std::size_t buffer_size) noexcept
+  {
+    detail::usdt_message_begin(buffer_size);
+  }
+
+  static void on_end(const stream_state&, const std::size_t written, const std::size_t read,
+                     const std::size_t buffer_size) noexcept
+  {
+    detail::usdt_message_end(written, read, buffer_size);
+  }
+
+  static void on_failure(const error_code code, const std::size_t offset, const std::source_location& location) noexcept
+  {
+    detail::usdt_failure(code, offset, location.function_name());
+  }
+
+  static void on_bulk_copy(const bool is_write, const std::size_t offset, const std::size_t size) noexcept
+  {
+    detail::usdt_bulk_copy(is_write, offset, size);
+  }
+};
+
+} // namespace bytepack
+
+#endif // BYTEPACK_USDT_HPP
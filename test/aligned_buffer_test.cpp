@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/aligned_buffer.hpp>
+
+#include <cstdint>
+
+namespace {
+
+bool is_aligned(const void* pointer, const std::size_t alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("Aligned buffers - owned stream buffers are cache-line aligned")
+{
+  for (const std::size_t size : { 1U, 7U, 64U, 1000U }) {
+    const bytepack::binary_stream stream(size);
+    REQUIRE(is_aligned(stream.data().as<void>(), bytepack::binary_stream<>::buffer_alignment));
+  }
+}
+
+TEST_CASE("Aligned buffers - aligned_buffer page modes")
+{
+  const std::size_t size = 3 * 1024 * 1024 + 5;
+  for (const auto mode : { bytepack::page_mode::default_pages, bytepack::page_mode::transparent_huge_pages,
+                           bytepack::page_mode::explicit_huge_pages }) {
+    bytepack::aligned_buffer storage(size, mode);
+    REQUIRE(storage);
+    REQUIRE(storage.size() == size);
+    REQUIRE(is_aligned(storage.data(), bytepack::aligned_buffer::alignment));
+    REQUIRE(storage.data()[size - 1] == 0);
+    if (mode == bytepack::page_mode::default_pages) {
+      REQUIRE_FALSE(storage.huge_pages());
+    }
+
+    bytepack::binary_stream stream(storage.view());
+    const std::vector<std::uint64_t> values(1000, 0x0102030405060708);
+    REQUIRE(stream.write(values));
+
+    bytepack::binary_stream reader(stream.data());
+    std::vector<std::uint64_t> values_;
+    REQUIRE(reader.read(values_));
+    REQUIRE(values_ == values);
+  }
+
+  bytepack::aligned_buffer empty(0);
+  REQUIRE_FALSE(empty);
+  REQUIRE(empty.view().size() == 0);
+
+  bytepack::aligned_buffer first(128);
+  bytepack::aligned_buffer second = std::move(first);
+  REQUIRE(second.size() == 128);
+  REQUIRE_FALSE(first);
+}
+
+TEST_CASE("Aligned buffers - bulk byte swap matches element-wise serialization")
+{
+  std::vector<std::uint16_t> u16(37);
+  std::vector<std::int32_t> i32(37);
+  std::vector<double> f64(37);
+  for (std::size_t i = 0; i < u16.size(); ++i) {
+    u16[i] = static_cast<std::uint16_t>(i * 1031);
+    i32[i] = -static_cast<std::int32_t>(i * 100003);
+    f64[i] = static_cast<double>(i) * 1.25e10;
+  }
+
+  bytepack::binary_stream bulk(1024);
+  REQUIRE(bulk.write<37>(u16));
+  REQUIRE(bulk.write<37>(i32));
+  REQUIRE(bulk.write<37>(f64));
+
+  bytepack::binary_stream single(1024);
+  for (const auto value : u16) {
+    REQUIRE(single.write(value));
+  }
+  for (const auto value : i32) {
+    REQUIRE(single.write(value));
+  }
+  for (const auto value : f64) {
+    REQUIRE(single.write(value));
+  }
+
+  REQUIRE(bulk.data().size() == single.data().size());
+  REQUIRE(std::memcmp(bulk.data().as<void>(), single.data().as<void>(), bulk.data().size()) == 0);
+
+  // Big-endian byte order of a single element
+  const auto* bytes = bulk.data().as<std::uint8_t>();
+  REQUIRE(bytes[2] == 0x04); // 1031 = 0x0407
+  REQUIRE(bytes[3] == 0x07);
+
+  bytepack::binary_stream reader(bulk.data());
+  std::vector<std::uint16_t> u16_;
+  std::vector<std::int32_t> i32_;
+  std::vector<double> f64_;
+  REQUIRE(reader.read<37>(u16_));
+  REQUIRE(reader.read<37>(i32_));
+  REQUIRE(reader.read<37>(f64_));
+  REQUIRE(u16_ == u16);
+  REQUIRE(i32_ == i32);
+  REQUIRE(f64_ == f64);
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+TEST_CASE("Std containers - map and unordered_map test (big-endian)")
+{
+  const std::map<std::uint16_t, std::string> map = { { 3, "three" }, { 1, "one" }, { 2, "two" } };
+  std::unordered_map<std::string, double> unordered_map;
+  for (int i = 0; i < 100; ++i) {
+    unordered_map.emplace("key-" + std::to_string(i), i * 0.5);
+  }
+
+  bytepack::binary_stream stream(4096);
+  REQUIRE(stream.write(map));
+  REQUIRE(stream.write<std::uint8_t>(unordered_map));
+
+  // Count prefix + sorted entries (key + length-prefixed value)
+  const auto* raw = stream.data().as<std::uint8_t>();
+  REQUIRE(raw[3] == 3);
+  REQUIRE(raw[5] == 1); // first key is the smallest one
+
+  std::map<std::uint16_t, std::string> map_ = { { 9, "stale" } };
+  std::unordered_map<std::string, double> unordered_map_{};
+
+  bytepack::binary_stream reader(stream.data());
+  REQUIRE(reader.read(map_));
+  REQUIRE(reader.read<std::uint8_t>(unordered_map_));
+  REQUIRE(map_ == map);
+  REQUIRE(unordered_map_ == unordered_map);
+}
+
+TEST_CASE("Std containers - map and sorted vector of pairs share the same format (little-endian)")
+{
+  const std::map<std::int32_t, std::array<float, 2>> map = { { -5, { 1.0f, 2.0f } }, { 10, { 3.0f, 4.0f } } };
+
+  bytepack::binary_stream<std::endian::little> stream(256);
+  REQUIRE(stream.write(map));
+
+  // Contiguous decode path
+  std::vector<std::pair<std::int32_t, std::array<float, 2>>> flat{};
+  bytepack::binary_stream<std::endian::little> reader(stream.data());
+  REQUIRE(reader.read(flat));
+  REQUIRE(flat.size() == 2);
+  REQUIRE(flat[0].first == -5);
+  REQUIRE(flat[1].second == std::array<float, 2>{ 3.0f, 4.0f });
+
+  // And back into a map
+  stream.reset();
+  REQUIRE(stream.write(flat));
+  std::map<std::int32_t, std::array<float, 2>> map_{};
+  REQUIRE(stream.read(map_));
+  REQUIRE(map_ == map);
+}
+
+TEST_CASE("Std containers - deque and list test (big-endian)")
+{
+  const std::deque<std::uint32_t> deque = { 1, 2, 3, 4, 5 };
+  const std::list<std::string> list = { "alpha", "beta", "" };
+  const std::list<std::vector<std::int16_t>> nested = { { 1, -1 }, {} };
+
+  bytepack::binary_stream stream(256);
+  REQUIRE(stream.write(deque, list, nested));
+  REQUIRE(stream.data().size() == (4 + 20) + (4 + 9 + 8 + 4) + (4 + 8 + 4));
+
+  std::deque<std::uint32_t> deque_ = { 9, 9, 9, 9, 9, 9, 9, 9 };
+  std::list<std::string> list_{};
+  std::list<std::vector<std::int16_t>> nested_{};
+
+  bytepack::binary_stream reader(stream.data());
+  REQUIRE(reader.read(deque_, list_, nested_));
+  REQUIRE(deque_ == deque);
+  REQUIRE(list_ == list);
+  REQUIRE(nested_ == nested);
+}
+
+TEST_CASE("Std containers - unsorted vector of pairs round trip")
+{
+  std::vector<std::pair<std::uint16_t, std::string>> pairs = { { 2, "two" }, { 1, "one" }, { 3, "three" } };
+
+  // Rejected on write as on read, nothing is written
+  bytepack::binary_stream stream(64);
+  REQUIRE_FALSE(stream.write(pairs));
+  REQUIRE(stream.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(stream.data().size() == 0);
+
+  std::ranges::sort(pairs);
+  bytepack::binary_stream sorted(64);
+  REQUIRE(sorted.write(pairs));
+  std::vector<std::pair<std::uint16_t, std::string>> pairs_{};
+  REQUIRE(sorted.read(pairs_));
+  REQUIRE(pairs_ == pairs);
+}
+
+TEST_CASE("Std containers - invalid associative container data")
+{
+  // Duplicate keys, written field by field as another implementation could send them
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(std::uint32_t{ 2 }, std::uint8_t{ 1 }, std::uint8_t{ 1 }, std::uint8_t{ 1 }, std::uint8_t{ 2 }));
+
+  std::map<std::uint8_t, std::uint8_t> map_{};
+  bytepack::binary_stream reader(stream.data());
+  REQUIRE_FALSE(reader.read(map_));
+  REQUIRE(reader.error().code == bytepack::error_code::invalid_value);
+
+  std::vector<std::pair<std::uint8_t, std::uint8_t>> flat_{};
+  bytepack::binary_stream flat_reader(stream.data());
+  REQUIRE_FALSE(flat_reader.read(flat_));
+  REQUIRE(flat_reader.error().code == bytepack::error_code::invalid_value);
+
+  // Unsorted keys in a sorted vector of pairs
+  stream.reset();
+  REQUIRE(stream.write(std::uint32_t{ 3 }, std::uint8_t{ 1 }, std::uint8_t{ 1 }, std::uint8_t{ 3 }, std::uint8_t{ 3 },
+                       std::uint8_t{ 2 }, std::uint8_t{ 2 }));
+  bytepack::binary_stream unsorted_reader(stream.data());
+  REQUIRE_FALSE(unsorted_reader.read(flat_));
+  REQUIRE(unsorted_reader.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(unsorted_reader.error().offset == 4 + 2 * 2); // third entry
+
+  // Element count larger than the remaining data
+  std::uint8_t corrupted[8]{ 0xFF, 0xFF, 0xFF, 0xFF, 1, 2, 3, 4 };
+  bytepack::binary_stream corrupted_reader(bytepack::buffer_view{ corrupted });
+  std::unordered_map<std::uint8_t, std::uint8_t> unordered_map_{};
+  REQUIRE_FALSE(corrupted_reader.read(unordered_map_));
+
+  // Not enough space: nothing is written
+  const std::map<std::uint32_t, std::uint32_t> map = { { 1, 1 }, { 2, 2 } };
+  bytepack::binary_stream small(12);
+  REQUIRE_FALSE(small.write(map));
+  REQUIRE(small.data().size() == 0);
+}
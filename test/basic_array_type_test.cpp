@@ -149,4 +149,30 @@ TEST_CASE("Basic array types - parameter pack (big-endian)")
   for (size_t i = 0; i < 28; i++) {
     REQUIRE(charArr[i] == charArr_[i]);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Basic array types - already serialized bytes")
+{
+  bytepack::binary_stream<std::endian::little> source(16);
+  REQUIRE(source.write(std::uint32_t{ 0x01020304 }, std::uint16_t{ 0x0506 }));
+
+  // Copied as they are: no size field and no byte order conversion in a big-endian stream
+  bytepack::binary_stream stream(8);
+  REQUIRE(stream.write(std::uint8_t{ 0xAA }));
+  REQUIRE(stream.write_bytes(source.data()));
+  REQUIRE(stream.data().size() == 7);
+  const auto* bytes = stream.data().as<std::uint8_t>();
+  REQUIRE(bytes[1] == 0x04);
+  REQUIRE(bytes[6] == 0x05);
+
+  REQUIRE(stream.write_bytes(bytepack::const_buffer_view(std::string_view(""))));
+  REQUIRE(stream.data().size() == 7);
+
+  // Does not fit: the stream is unchanged
+  REQUIRE_FALSE(stream.write_bytes(source.data()));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.error().offset == 7);
+  REQUIRE(stream.data().size() == 7);
+  REQUIRE(stream.write(std::uint8_t{ 0xBB }));
+  REQUIRE(stream.data().size() == 8);
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+#include <limits>
+#include <random>
+
+namespace {
+
+// Round trip of values in [base, base + 2^width - 1], with the largest delta at the start
+template<typename T, std::endian E = std::endian::big>
+std::size_t round_trip_mismatches(const std::size_t count, const unsigned width, std::mt19937_64& rng)
+{
+  using U = std::make_unsigned_t<T>;
+  const T base = std::numeric_limits<T>::min() / 2;
+  const std::uint64_t mask = width >= 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << width) - 1;
+  std::vector<T> values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint64_t delta = i == 0 ? mask : rng() & mask;
+    values[i] = static_cast<T>(static_cast<U>(static_cast<U>(base) + static_cast<U>(delta)));
+  }
+
+  bytepack::binary_stream<E> stream(count * sizeof(T) + 64);
+  if (!stream.template write<bytepack::bit_packed>(values)) {
+    return count + 1;
+  }
+  std::vector<T> decoded;
+  if (!stream.template read<bytepack::bit_packed>(decoded) || decoded.size() != count
+      || stream.read_offset() != stream.data().size()) {
+    return count + 1;
+  }
+
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (decoded[i] != values[i]) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+} // namespace
+
+TEST_CASE("Bit packing - encoded size")
+{
+  // 11-bit ADC readings: 1000 values = 7 full blocks of 128 + 104
+  std::vector<std::uint32_t> readings(1000);
+  for (std::size_t i = 0; i < readings.size(); ++i) {
+    // Each block contains the minimum (1000) and the maximum (1000 + 2047)
+    readings[i] = 1000 + (i % 128 == 0 ? 0 : (i % 128 == 1 ? 2047 : static_cast<std::uint32_t>((i * 37) % 2048)));
+  }
+  bytepack::binary_stream stream(8192);
+  REQUIRE(stream.write<bytepack::bit_packed>(readings));
+
+  const std::size_t full_blocks = 7 * (4 + 1 + 4 * 11 * 4);
+  const std::size_t last_block = 4 + 1 + (104 * 11 + 7) / 8;
+  REQUIRE(stream.data().size() == 4 + full_blocks + last_block);
+  REQUIRE(stream.data().size() < readings.size() * sizeof(std::uint32_t) / 2);
+
+  std::vector<std::uint32_t> decoded;
+  REQUIRE(stream.read<bytepack::bit_packed>(decoded));
+  REQUIRE(decoded == readings);
+
+  // Constant values: width 0, only the base
+  const std::array<std::int16_t, 128> constant = [] {
+    std::array<std::int16_t, 128> values{};
+    values.fill(-5);
+    return values;
+  }();
+  stream.reset();
+  REQUIRE(stream.write<bytepack::bit_packed>(constant));
+  REQUIRE(stream.data().size() == 3);
+  std::array<std::int16_t, 128> constant_decoded{};
+  REQUIRE(stream.read<bytepack::bit_packed>(constant_decoded));
+  REQUIRE(constant_decoded == constant);
+}
+
+TEST_CASE("Bit packing - all widths and integer types")
+{
+  std::mt19937_64 rng(42);
+  std::size_t mismatches = 0;
+  for (const std::size_t count : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 127 }, std::size_t{ 128 },
+                                   std::size_t{ 300 }, std::size_t{ 513 } }) {
+    for (unsigned width = 0; width <= 64; ++width) {
+      if (width <= 8) {
+        mismatches += round_trip_mismatches<std::uint8_t>(count, width, rng);
+        mismatches += round_trip_mismatches<std::int8_t, std::endian::little>(count, width, rng);
+      }
+      if (width <= 16) {
+        mismatches += round_trip_mismatches<std::int16_t>(count, width, rng);
+      }
+      if (width <= 32) {
+        mismatches += round_trip_mismatches<std::uint32_t>(count, width, rng);
+        mismatches += round_trip_mismatches<std::int32_t, std::endian::little>(count, width, rng);
+      }
+      mismatches += round_trip_mismatches<std::int64_t>(count, width, rng);
+      mismatches += round_trip_mismatches<std::uint64_t, std::endian::little>(count, width, rng);
+    }
+  }
+  REQUIRE(mismatches == 0);
+
+  // Full range, including the minimum and maximum
+  std::array<std::int32_t, 256> extremes{};
+  for (std::size_t i = 0; i < extremes.size(); ++i) {
+    extremes[i] = i % 2 == 0 ? std::numeric_limits<std::int32_t>::min() : std::numeric_limits<std::int32_t>::max();
+  }
+  bytepack::binary_stream stream(2048);
+  REQUIRE(stream.write<bytepack::bit_packed>(extremes));
+  std::int32_t decoded[256]{};
+  REQUIRE(stream.read<bytepack::bit_packed>(decoded));
+  REQUIRE(std::equal(extremes.begin(), extremes.end(), decoded));
+}
+
+TEST_CASE("Bit packing - errors")
+{
+  std::vector<std::uint16_t> values(200, 7);
+  values[150] = 1000;
+
+  SECTION("buffer overflow restores the write position")
+  {
+    bytepack::binary_stream stream(40);
+    REQUIRE(stream.write(std::uint8_t{ 1 }));
+    REQUIRE_FALSE(stream.write<bytepack::bit_packed, std::uint16_t>(values));
+    REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+    REQUIRE(stream.data().size() == 1);
+  }
+
+  SECTION("invalid bit width")
+  {
+    std::uint8_t bytes[]{ 0x00, 0x01, 0x00, 0x00, 0x11, 0xFF, 0xFF, 0xFF };
+    bytepack::binary_reader reader(bytepack::const_buffer_view{ bytes });
+    std::vector<std::uint16_t> decoded;
+    REQUIRE_FALSE(reader.read<bytepack::bit_packed, std::uint16_t>(decoded));
+    REQUIRE(reader.error().code == bytepack::error_code::invalid_value);
+    REQUIRE(reader.error().offset == 2);
+  }
+
+  SECTION("truncated data")
+  {
+    bytepack::binary_stream stream(1024);
+    REQUIRE(stream.write<bytepack::bit_packed>(values));
+    bytepack::binary_reader reader(bytepack::const_buffer_view(stream.data().as<std::uint8_t>(), 50));
+    std::vector<std::uint16_t> decoded;
+    REQUIRE_FALSE(reader.read<bytepack::bit_packed>(decoded));
+    REQUIRE(reader.error().code == bytepack::error_code::buffer_overflow);
+  }
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/compression.hpp>
+
+TEST_CASE("Compression - byte shuffle and bit shuffle round trip")
+{
+  std::uint8_t src[35]{};
+  for (std::uint8_t i = 0; i < sizeof(src); ++i) {
+    src[i] = static_cast<std::uint8_t>(i * 7 + 3);
+  }
+  std::uint8_t shuffled[35]{};
+  std::uint8_t restored[35]{};
+
+  REQUIRE(bytepack::byte_shuffle<4>(bytepack::buffer_view(src), bytepack::buffer_view(shuffled)));
+  // n-th bytes of the 8 elements are grouped together, trailing 3 bytes are copied as they are
+  REQUIRE(shuffled[0] == src[0]);
+  REQUIRE(shuffled[1] == src[4]);
+  REQUIRE(shuffled[8] == src[1]);
+  REQUIRE(shuffled[34] == src[34]);
+  REQUIRE(bytepack::byte_unshuffle<4>(bytepack::buffer_view(shuffled), bytepack::buffer_view(restored)));
+  REQUIRE(std::memcmp(src, restored, sizeof(src)) == 0);
+
+  std::memset(restored, 0, sizeof(restored));
+  REQUIRE(bytepack::bit_shuffle<2>(bytepack::buffer_view(src), bytepack::buffer_view(shuffled)));
+  REQUIRE(bytepack::bit_unshuffle<2>(bytepack::buffer_view(shuffled), bytepack::buffer_view(restored)));
+  REQUIRE(std::memcmp(src, restored, sizeof(src)) == 0);
+
+  // Bit planes: only bit 0 of the second element is set
+  std::uint8_t bits[8]{ 0, 1, 0, 0, 0, 0, 0, 0 };
+  std::uint8_t planes[8]{};
+  REQUIRE(bytepack::bit_shuffle<1>(bytepack::buffer_view(bits), bytepack::buffer_view(planes)));
+  REQUIRE(planes[0] == 0x02);
+  REQUIRE(planes[1] == 0x00);
+
+  std::uint8_t small[34]{};
+  REQUIRE_FALSE(bytepack::byte_shuffle<4>(bytepack::buffer_view(src), bytepack::buffer_view(small)));
+}
+
+TEST_CASE("Compression - LZ codec round trip")
+{
+  std::string text;
+  for (int i = 0; i < 200; ++i) {
+    text += "voltage=230.0;current=12.5;";
+    text += std::to_string(i % 7);
+  }
+  std::vector<std::uint8_t> compressed(bytepack::lz_compress_bound(text.size()));
+  std::vector<std::uint8_t> decompressed(text.size());
+
+  const auto packed =
+    bytepack::lz_compress(bytepack::buffer_view(text), bytepack::buffer_view(compressed.data(), compressed.size()));
+  REQUIRE(packed);
+  REQUIRE(packed.size() < text.size() / 10);
+
+  const auto unpacked =
+    bytepack::lz_decompress(packed, bytepack::buffer_view(decompressed.data(), decompressed.size()));
+  REQUIRE(unpacked.size() == text.size());
+  REQUIRE(std::memcmp(unpacked.as<char>(), text.data(), text.size()) == 0);
+
+  // Incompressible (pseudo-random) data and overlapping matches
+  std::vector<std::uint8_t> data(5000);
+  std::uint32_t state = 12345;
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    state = state * 1103515245U + 12345U;
+    data[i] = i > 4000 ? std::uint8_t{ 0xAB } : static_cast<std::uint8_t>(state >> 24);
+  }
+  compressed.resize(bytepack::lz_compress_bound(data.size()));
+  decompressed.resize(data.size());
+  const auto packed2 = bytepack::lz_compress(bytepack::buffer_view(data.data(), data.size()),
+                                             bytepack::buffer_view(compressed.data(), compressed.size()));
+  REQUIRE(packed2);
+  const auto unpacked2 =
+    bytepack::lz_decompress(packed2, bytepack::buffer_view(decompressed.data(), decompressed.size()));
+  REQUIRE(unpacked2.size() == data.size());
+  REQUIRE(decompressed == data);
+
+  // Destination too small
+  REQUIRE_FALSE(bytepack::lz_decompress(packed2, bytepack::buffer_view(decompressed.data(), data.size() - 1)));
+  REQUIRE_FALSE(bytepack::lz_compress(bytepack::buffer_view(data.data(), data.size()),
+                                      bytepack::buffer_view(compressed.data(), 100)));
+
+  // Truncated input
+  REQUIRE_FALSE(bytepack::lz_decompress(bytepack::buffer_view(compressed.data(), packed2.size() - 1),
+                                        bytepack::buffer_view(decompressed.data(), decompressed.size())));
+}
+
+TEST_CASE("Compression - compression stage over binary_stream data")
+{
+  std::vector<float> voltages(1024);
+  for (std::size_t i = 0; i < voltages.size(); ++i) {
+    voltages[i] = 230.0f + static_cast<float>(i % 16) * 0.25f;
+  }
+
+  bytepack::binary_stream stream(8192);
+  REQUIRE(stream.write(std::uint32_t{ 77 }));
+  REQUIRE(stream.write(voltages));
+
+  bytepack::compression_stage stage;
+  std::vector<std::uint8_t> frame(bytepack::compression_stage::frame_bound(stream.data().size()));
+  std::vector<std::uint8_t> received(stream.data().size());
+
+  const auto plain = stage.compress(stream.data(), bytepack::buffer_view(frame.data(), frame.size()));
+  const std::size_t plain_size = plain.size();
+  REQUIRE(plain);
+
+  const auto shuffled = stage.compress<bytepack::shuffle_filter::byte, sizeof(float)>(
+    stream.data(), bytepack::buffer_view(frame.data(), frame.size()));
+  REQUIRE(shuffled);
+  REQUIRE(shuffled.size() <= plain_size);
+
+  const auto output = stage.decompress(shuffled, bytepack::buffer_view(received.data(), received.size()));
+  REQUIRE(output.size() == stream.data().size());
+
+  bytepack::binary_stream reader(output);
+  std::uint32_t id{};
+  std::vector<float> voltages_{};
+  REQUIRE(reader.read(id, voltages_));
+  REQUIRE(id == 77);
+  REQUIRE(voltages_ == voltages);
+
+  const auto bit_shuffled = stage.compress<bytepack::shuffle_filter::bit, sizeof(float)>(
+    stream.data(), bytepack::buffer_view(frame.data(), frame.size()));
+  REQUIRE(bit_shuffled);
+  std::fill(received.begin(), received.end(), std::uint8_t{ 0 });
+  REQUIRE(stage.decompress(bit_shuffled, bytepack::buffer_view(received.data(), received.size())).size()
+          == stream.data().size());
+  REQUIRE(std::memcmp(received.data(), stream.data().as<std::uint8_t>(), received.size()) == 0);
+
+  // Destination smaller than the uncompressed size
+  REQUIRE_FALSE(stage.decompress(bit_shuffled, bytepack::buffer_view(received.data(), received.size() - 1)));
+
+  // Frame in immutable memory (e.g. a received packet kept as const)
+  const std::vector<std::uint8_t> const_frame(bit_shuffled.as<std::uint8_t>(),
+                                              bit_shuffled.as<std::uint8_t>() + bit_shuffled.size());
+  REQUIRE(stage
+            .decompress(bytepack::const_buffer_view(const_frame.data(), const_frame.size()),
+                        bytepack::buffer_view(received.data(), received.size()))
+            .size()
+          == stream.data().size());
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+#include <thread>
+
+namespace {
+
+struct Packet
+{
+  std::uint16_t id{};
+  std::int32_t value{};
+  std::string name;
+  std::vector<std::uint8_t> payload;
+
+  template<std::endian E>
+  bool serialize(bytepack::binary_stream<E>& stream) const noexcept
+  {
+    return stream.write(id, value, name, payload);
+  }
+
+  template<typename Stream>
+  bool deserialize(Stream& stream) noexcept
+  {
+    return stream.read(id, value, name, payload);
+  }
+};
+
+// id: 42, value: -2, name: "hi" (4-byte length prefix), flag: 1
+constexpr std::array<std::uint8_t, 13> raw_packet{ 0x00, 0x2A, 0xFF, 0xFF, 0xFF, 0xFE, 0x00,
+                                                   0x00, 0x00, 0x02, 'h',  'i',  0x01 };
+
+} // namespace
+
+// A reader does not own a buffer
+static_assert(std::is_constructible_v<bytepack::binary_stream<>, std::size_t>);
+static_assert(std::is_constructible_v<bytepack::binary_reader<>, std::size_t> == false);
+
+// ... and never exposes its data as writable memory
+static_assert(std::is_same_v<decltype(std::declval<bytepack::binary_reader<>&>().data()), bytepack::const_buffer_view>);
+static_assert(std::is_same_v<decltype(std::declval<bytepack::binary_stream<>&>().data()), bytepack::buffer_view>);
+
+TEST_CASE("Const buffer view - construction")
+{
+  const std::uint8_t array[]{ 1, 2, 3 };
+  const bytepack::const_buffer_view from_array(array);
+  REQUIRE(from_array.size() == 3);
+  REQUIRE(from_array.as<std::uint8_t>() == array);
+
+  const bytepack::const_buffer_view from_literal(std::string_view("literal"));
+  REQUIRE(from_literal.size() == 7);
+  REQUIRE(from_literal.ssize() == 7);
+
+  const std::string str = "string";
+  const bytepack::const_buffer_view from_string(str);
+  REQUIRE(from_string.as<char>() == str.data());
+
+  const std::vector<std::int16_t> values{ 1, 2 };
+  const bytepack::const_buffer_view from_pointer(values.data(), values.size());
+  REQUIRE(from_pointer.size() == 4);
+
+  std::uint8_t mutable_bytes[4]{};
+  const bytepack::const_buffer_view from_buffer_view = bytepack::buffer_view(mutable_bytes);
+  REQUIRE(from_buffer_view.size() == 4);
+  REQUIRE(from_buffer_view);
+
+  const bytepack::const_buffer_view empty(static_cast<const void*>(nullptr), 0);
+  REQUIRE(empty.is_empty());
+  REQUIRE_FALSE(empty);
+}
+
+TEST_CASE("Binary reader - reads from immutable memory")
+{
+  SECTION("constexpr array")
+  {
+    bytepack::binary_reader reader(bytepack::const_buffer_view{ raw_packet });
+    std::uint16_t id{};
+    std::int32_t value{};
+    std::string name;
+    std::uint8_t flag{};
+    REQUIRE(reader.read(id, value, name));
+    REQUIRE(reader.read(flag));
+    REQUIRE(id == 42);
+    REQUIRE(value == -2);
+    REQUIRE(name == "hi");
+    REQUIRE(flag == 1);
+    REQUIRE(reader.read_offset() == raw_packet.size());
+
+    REQUIRE_FALSE(reader.read(flag));
+    REQUIRE(reader.error().code == bytepack::error_code::buffer_overflow);
+  }
+
+  SECTION("string literal")
+  {
+    bytepack::binary_reader<std::endian::little> reader(bytepack::const_buffer_view(std::string_view("\x01\x02OK")));
+    std::uint16_t value{};
+    char text[2]{};
+    REQUIRE(reader.read(value, text));
+    REQUIRE(value == 0x0201);
+    REQUIRE(std::string_view(text, 2) == "OK");
+  }
+
+  SECTION("serialized message")
+  {
+    const Packet expected{ 7, -100, "const", { 1, 2, 3 } };
+    bytepack::binary_stream stream(64);
+    REQUIRE(expected.serialize(stream));
+    const std::string bytes(stream.data().as<char>(), stream.data().size());
+
+    bytepack::binary_reader reader(bytepack::const_buffer_view{ bytes });
+    Packet packet{};
+    REQUIRE(packet.deserialize(reader));
+    REQUIRE(packet.id == expected.id);
+    REQUIRE(packet.value == expected.value);
+    REQUIRE(packet.name == expected.name);
+    REQUIRE(packet.payload == expected.payload);
+  }
+}
+
+TEST_CASE("Binary reader - concurrent readers of shared data")
+{
+  const Packet expected{ 1, 2, std::string(100, 'x'), std::vector<std::uint8_t>(1000, 0xAB) };
+  bytepack::binary_stream stream(2048);
+  REQUIRE(expected.serialize(stream));
+  const std::vector<std::uint8_t> shared(stream.data().as<std::uint8_t>(),
+                                         stream.data().as<std::uint8_t>() + stream.data().size());
+
+  std::array<std::size_t, 4> failures{};
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    threads.emplace_back([&shared, &expected, &failures, t] {
+      for (int i = 0; i < 1000; ++i) {
+        bytepack::binary_reader reader(bytepack::const_buffer_view(shared.data(), shared.size()));
+        Packet packet{};
+        if (!packet.deserialize(reader) || packet.name != expected.name || packet.payload != expected.payload) {
+          ++failures[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(failures == std::array<std::size_t, 4>{});
+}
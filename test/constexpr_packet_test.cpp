@@ -0,0 +1,82 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+enum class MessageType : std::uint8_t { Heartbeat = 1, Control = 2 };
+
+constexpr auto heartbeat = bytepack::make_packet(std::uint8_t{ 0xA5 }, MessageType::Heartbeat, std::uint16_t{ 0x0102 },
+                                                 std::int32_t{ -2 });
+
+constexpr char station[8] = "TR-0042";
+constexpr std::array<float, 2> limits = { 1.5f, -0.25f };
+constexpr auto control = bytepack::make_packet<std::endian::little>(MessageType::Control, station, limits, 2.0, true);
+
+constexpr auto reading = bytepack::make_packet(1.0, -2.0f);
+
+} // namespace
+
+TEST_CASE("Constexpr packets - built at compile time")
+{
+  static_assert(heartbeat.size() == 1 + 1 + 2 + 4);
+  static_assert(heartbeat[0] == 0xA5);
+  static_assert(heartbeat[1] == 1);
+  static_assert(heartbeat[2] == 0x01 && heartbeat[3] == 0x02);
+  static_assert(heartbeat[4] == 0xFF && heartbeat[7] == 0xFE);
+
+  static_assert(control.size() == 1 + 8 + 8 + 8 + 1);
+  static_assert(control[1] == 'T' && control[8] == '\0');
+
+  // Read back at compile time
+  static_assert([] {
+    std::uint8_t magic{};
+    MessageType type{};
+    std::uint16_t version{};
+    std::int32_t value{};
+    return bytepack::read_packet(heartbeat, magic, type, version, value) && magic == 0xA5
+           && type == MessageType::Heartbeat && version == 0x0102 && value == -2;
+  }());
+
+  // Floating-point values in big-endian packets are byte swapped at compile time as well
+  static_assert(reading[0] == 0x3F && reading[1] == 0xF0 && reading[7] == 0x00);
+  static_assert(reading[8] == 0xC0 && reading[11] == 0x00);
+  static_assert([] {
+    double value{};
+    float offset{};
+    return bytepack::read_packet(reading, value, offset) && value == 1.0 && offset == -2.0f;
+  }());
+}
+
+TEST_CASE("Constexpr packets - same format as binary_stream")
+{
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(std::uint8_t{ 0xA5 }, MessageType::Heartbeat, std::uint16_t{ 0x0102 }, std::int32_t{ -2 }));
+  REQUIRE(stream.data().size() == heartbeat.size());
+  REQUIRE(std::memcmp(stream.data().as<void>(), heartbeat.data(), heartbeat.size()) == 0);
+
+  bytepack::binary_stream<std::endian::little> little_stream(64);
+  REQUIRE(little_stream.write(MessageType::Control, station, limits, 2.0, true));
+  REQUIRE(little_stream.data().size() == control.size());
+  REQUIRE(std::memcmp(little_stream.data().as<void>(), control.data(), control.size()) == 0);
+
+  // Precomputed packets are written with a single copy
+  bytepack::binary_stream send_stream(64);
+  REQUIRE(send_stream.write(heartbeat));
+  REQUIRE(send_stream.data().size() == heartbeat.size());
+
+  MessageType type{};
+  char station_[8]{};
+  std::array<float, 2> limits_{};
+  double ratio{};
+  bool enabled{};
+  REQUIRE(bytepack::read_packet<std::endian::little>(control, type, station_, limits_, ratio, enabled));
+  REQUIRE(type == MessageType::Control);
+  REQUIRE_THAT(station_, Catch::Matchers::Equals(station));
+  REQUIRE(limits_ == limits);
+  REQUIRE(ratio == 2.0);
+  REQUIRE(enabled);
+
+  std::uint64_t too_large[2]{};
+  REQUIRE_FALSE(bytepack::read_packet(heartbeat, too_large));
+}
@@ -0,0 +1,187 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/delta.hpp>
+
+namespace {
+
+// timestamp, identifier, voltage[3], temperature, status flags, alarm codes, reserved[2], peak load, humidity
+using TelemetryLayout =
+  bytepack::field_layout<std::int64_t, std::uint32_t, float[3], float, std::uint8_t, std::uint16_t,
+                         std::array<std::uint32_t, 2>, std::uint32_t, std::uint8_t>;
+
+struct Telemetry
+{
+  std::int64_t timestamp;
+  std::uint32_t identifier;
+  float voltage[3];
+  float temperature;
+  std::uint8_t status_flags;
+  std::uint16_t alarm_codes;
+  std::array<std::uint32_t, 2> reserved;
+  std::uint32_t peak_load;
+  std::uint8_t humidity;
+};
+
+template<std::endian BufferEndian>
+bool encode(bytepack::delta_encoder<TelemetryLayout, BufferEndian>& encoder,
+            bytepack::binary_stream<BufferEndian>& stream, const Telemetry& t)
+{
+  return encoder.encode(stream, t.timestamp, t.identifier, t.voltage, t.temperature, t.status_flags, t.alarm_codes,
+                        t.reserved, t.peak_load, t.humidity);
+}
+
+template<std::endian BufferEndian>
+bool decode(bytepack::delta_decoder<TelemetryLayout, BufferEndian>& decoder,
+            bytepack::binary_stream<BufferEndian>& stream, Telemetry& t)
+{
+  return decoder.decode(stream, t.timestamp, t.identifier, t.voltage, t.temperature, t.status_flags, t.alarm_codes,
+                        t.reserved, t.peak_load, t.humidity);
+}
+
+void require_equal(const Telemetry& a, const Telemetry& b)
+{
+  REQUIRE(a.timestamp == b.timestamp);
+  REQUIRE(a.identifier == b.identifier);
+  REQUIRE(std::memcmp(a.voltage, b.voltage, sizeof(a.voltage)) == 0);
+  REQUIRE(a.temperature == b.temperature);
+  REQUIRE(a.status_flags == b.status_flags);
+  REQUIRE(a.alarm_codes == b.alarm_codes);
+  REQUIRE(a.reserved == b.reserved);
+  REQUIRE(a.peak_load == b.peak_load);
+  REQUIRE(a.humidity == b.humidity);
+}
+
+} // namespace
+
+TEST_CASE("Delta encoding - key frames and delta frames (big-endian)")
+{
+  bytepack::delta_encoder<TelemetryLayout> encoder(4);
+  bytepack::delta_decoder<TelemetryLayout> decoder;
+
+  Telemetry telemetry{ 1701037875, 7, { 229.5f, 230.0f, 231.5f }, 45.5f, 0x01, 0, { 0, 0 }, 1000, 40 };
+
+  std::uint8_t raw[256]{};
+  bytepack::binary_stream stream(bytepack::buffer_view{ raw });
+
+  // First frame is a key frame: frame type + all fields
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(stream.data().size() == 1 + TelemetryLayout::size);
+  REQUIRE(raw[0] == static_cast<std::uint8_t>(bytepack::delta_frame_type::key_frame));
+
+  Telemetry decoded{};
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+
+  // Only the timestamp and humidity change: frame type + 2 bytes bitmap + 8 + 1 bytes
+  stream.reset();
+  telemetry.timestamp += 1;
+  telemetry.humidity = 41;
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(stream.data().size() == 1 + 2 + 8 + 1);
+  REQUIRE(raw[0] == static_cast<std::uint8_t>(bytepack::delta_frame_type::delta_frame));
+  REQUIRE(raw[1] == 0x01);
+  REQUIRE(raw[2] == 0x01);
+
+  decoded.timestamp = 0; // decoder must restore unchanged fields from its own snapshot
+  decoded.voltage[1] = 0.0f;
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+
+  // Nothing changes: empty bitmap
+  stream.reset();
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(stream.data().size() == 1 + 2);
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+
+  // Array element change
+  stream.reset();
+  telemetry.voltage[2] = 232.0f;
+  telemetry.reserved[1] = 9;
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(stream.data().size() == 1 + 2 + 12 + 8);
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+
+  // Every 4th frame is a key frame
+  stream.reset();
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(raw[0] == static_cast<std::uint8_t>(bytepack::delta_frame_type::key_frame));
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+}
+
+TEST_CASE("Delta encoding - receiver synchronization (little-endian)")
+{
+  bytepack::delta_encoder<TelemetryLayout, std::endian::little> encoder;
+  bytepack::delta_decoder<TelemetryLayout, std::endian::little> decoder;
+
+  Telemetry telemetry{ 1, 2, { 3.0f, 4.0f, 5.0f }, 6.0f, 7, 8, { 9, 10 }, 11, 12 };
+  Telemetry decoded{};
+
+  bytepack::binary_stream<std::endian::little> stream(256);
+  REQUIRE(encode(encoder, stream, telemetry));
+
+  telemetry.alarm_codes = 99;
+  REQUIRE(encode(encoder, stream, telemetry));
+
+  // Receiver joins late: delta frame without a key frame is rejected
+  bytepack::binary_stream<std::endian::little> late_stream(stream.data());
+  REQUIRE(decode(decoder, late_stream, decoded) == true); // key frame
+  REQUIRE(decode(decoder, late_stream, decoded) == true); // delta frame
+  require_equal(telemetry, decoded);
+
+  decoder.reset();
+  stream.reset();
+  telemetry.alarm_codes = 100;
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE_FALSE(decode(decoder, stream, decoded));
+  REQUIRE(stream.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(stream.error().offset == 0);
+
+  encoder.force_key_frame();
+  stream.reset();
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(decode(decoder, stream, decoded));
+  require_equal(telemetry, decoded);
+
+  // Not enough space for the frame: nothing is written and the snapshot of the encoder is not updated
+  bytepack::binary_stream<std::endian::little> small_stream(8);
+  telemetry.temperature = 7.0f;
+  telemetry.timestamp = 2;
+  REQUIRE_FALSE(encode(encoder, small_stream, telemetry));
+  REQUIRE(small_stream.data().size() == 0);
+  stream.reset();
+  REQUIRE(encode(encoder, stream, telemetry));
+  REQUIRE(stream.data().size() == 1 + 2 + 8 + 4);
+}
+
+TEST_CASE("Delta encoding - invalid frames")
+{
+  bytepack::delta_decoder<TelemetryLayout> decoder;
+  Telemetry decoded{};
+
+  // Unknown frame type, after a valid key frame
+  bytepack::delta_encoder<TelemetryLayout> encoder;
+  bytepack::binary_stream stream(256);
+  REQUIRE(encode(encoder, stream, Telemetry{ 1, 2, { 3.0f, 4.0f, 5.0f }, 6.0f, 7, 8, { 9, 10 }, 11, 12 }));
+  const std::size_t key_frame_size = stream.data().size();
+  REQUIRE(stream.write(std::uint8_t{ 7 }));
+  REQUIRE(decode(decoder, stream, decoded));
+  REQUIRE_FALSE(decode(decoder, stream, decoded));
+  REQUIRE(stream.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(stream.error().offset == key_frame_size);
+
+  // Bit of a 10th field in the bitmap of a 9-field layout
+  std::uint8_t unknown_field[]{ 0x01, 0x00, 0x02 };
+  bytepack::binary_stream unknown_stream(bytepack::buffer_view{ unknown_field });
+  REQUIRE_FALSE(decode(decoder, unknown_stream, decoded));
+  REQUIRE(unknown_stream.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(unknown_stream.error().offset == 1);
+
+  // Sticky mode: later reads of the stream fail as well
+  bytepack::binary_stream sticky(bytepack::buffer_view{ unknown_field }, bytepack::ErrorMode::Sticky);
+  REQUIRE_FALSE(decode(decoder, sticky, decoded));
+  std::uint8_t byte{};
+  REQUIRE_FALSE(sticky.read(byte));
+}
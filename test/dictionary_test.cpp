@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/dictionary.hpp>
+
+TEST_CASE("Dictionary encoding - batch of messages")
+{
+  // Message i has the device id devices[i % 3], the serial number serials[i % 5] and the value i
+  const char devices[3][16]{ "device-0", "device-1", "device-2" };
+  const std::string serials[5]{ "SN-2024-0", "SN-2024-1", "SN-2024-2", "SN-2024-3", "SN-2024-4" };
+  constexpr int batch_size = 100;
+  bytepack::binary_stream stream(4096);
+  bytepack::dictionary_encoder encoder;
+  std::size_t failures = 0;
+  for (int i = 0; i < batch_size; ++i) {
+    if (!encoder.write(stream, devices[i % 3]) || !encoder.write(stream, serials[i % 5])
+        || !stream.write(static_cast<float>(i))) {
+      ++failures;
+    }
+  }
+  REQUIRE(failures == 0);
+  REQUIRE(encoder.size() == 3 + 5);
+
+  // Strings are written once: 8 table entries, then 1-byte indices
+  const std::size_t table_size = 3 * (1 + 2 + 16) + 5 * (1 + 2 + 9);
+  const std::size_t index_size = (batch_size - 3) + (batch_size - 5);
+  REQUIRE(stream.data().size() == table_size + index_size + batch_size * sizeof(float));
+
+  const std::string received(stream.data().as<char>(), stream.data().size());
+  bytepack::binary_reader reader(bytepack::const_buffer_view{ received });
+  bytepack::dictionary_decoder decoder;
+  std::size_t mismatches = 0;
+  for (int i = 0; i < batch_size; ++i) {
+    char device_id[16]{};
+    std::string_view serial_number;
+    float value{};
+    if (!decoder.read(reader, device_id) || !decoder.read(reader, serial_number) || !reader.read(value)
+        || std::memcmp(device_id, devices[i % 3], 16) != 0 || serial_number != serials[i % 5]
+        || value != static_cast<float>(i)) {
+      ++mismatches;
+    }
+    // Views refer to the received buffer
+    if (serial_number.data() < received.data() || serial_number.data() >= received.data() + received.size()) {
+      ++mismatches;
+    }
+  }
+  REQUIRE(mismatches == 0);
+  REQUIRE(decoder.table().size() == 8);
+  REQUIRE(reader.read_offset() == received.size());
+}
+
+TEST_CASE("Dictionary encoding - reset, varints and errors")
+{
+  bytepack::binary_stream<std::endian::little> stream(4096);
+  bytepack::dictionary_encoder<std::uint8_t> encoder;
+
+  // 200 distinct strings: indices above 127 take 2 bytes
+  std::size_t failures = 0;
+  for (int i = 0; i < 200; ++i) {
+    failures += encoder.write(stream, std::to_string(i)) ? 0U : 1U;
+  }
+  REQUIRE(failures == 0);
+  const std::size_t table_end = stream.data().size();
+  REQUIRE(encoder.write(stream, std::string_view("5")));
+  REQUIRE(stream.data().size() == table_end + 1);
+  REQUIRE(encoder.write(stream, std::string_view("150")));
+  REQUIRE(stream.data().size() == table_end + 3);
+
+  // New batch: the table starts again
+  encoder.reset();
+  REQUIRE(encoder.write(stream, std::string_view("150")));
+  REQUIRE(stream.data().size() == table_end + 3 + 1 + 1 + 3);
+
+  bytepack::binary_stream<std::endian::little> input(stream.data());
+  bytepack::dictionary_decoder<std::uint8_t> decoder;
+  std::string_view value;
+  for (int i = 0; i < 200; ++i) {
+    failures += decoder.read(input, value) && value == std::to_string(i) ? 0U : 1U;
+  }
+  REQUIRE(failures == 0);
+  REQUIRE(decoder.read(input, value));
+  REQUIRE(value == "5");
+  REQUIRE(decoder.read(input, value));
+  REQUIRE(value == "150");
+  decoder.reset();
+  REQUIRE(decoder.read(input, value));
+  REQUIRE(value == "150");
+
+  SECTION("invalid index")
+  {
+    std::uint8_t bytes[]{ 0x00, 0x01, 'A', 0x02 };
+    bytepack::binary_reader bad(bytepack::const_buffer_view{ bytes });
+    bytepack::dictionary_decoder<std::uint8_t> bad_decoder;
+    REQUIRE(bad_decoder.read(bad, value));
+    REQUIRE(value == "A");
+    REQUIRE_FALSE(bad_decoder.read(bad, value)); // index 1 is not in the table
+  }
+
+  SECTION("string longer than the size type")
+  {
+    REQUIRE_FALSE(encoder.write(stream, std::string(300, 'x')));
+    REQUIRE(stream.error().code == bytepack::error_code::size_overflow);
+    REQUIRE(encoder.size() == 1);
+  }
+}
+
+TEST_CASE("Zero-copy string_view read")
+{
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(std::string_view("zero-copy"), std::uint8_t{ 7 }));
+
+  std::string_view text;
+  std::uint8_t number{};
+  REQUIRE(stream.read(text, number));
+  REQUIRE(text == "zero-copy");
+  REQUIRE(text.data() == stream.data().as<char>() + 4);
+  REQUIRE(number == 7);
+
+  // Truncated string
+  bytepack::binary_reader truncated(bytepack::const_buffer_view(stream.data().as<std::uint8_t>(), 8));
+  REQUIRE_FALSE(truncated.read(text));
+  REQUIRE(truncated.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(truncated.error().offset == 0);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+struct Telemetry
+{
+  std::uint8_t byte_order{}; // 0: big-endian, 1: little-endian
+  std::uint16_t sensor_id{};
+  double value{};
+  std::vector<std::int32_t> samples;
+  std::string label;
+
+  template<std::endian E>
+  bool serialize(bytepack::binary_stream<E>& stream) const noexcept
+  {
+    return stream.write(byte_order, sensor_id, value, samples, label);
+  }
+
+  template<std::endian E>
+  bool deserialize(bytepack::binary_stream<E>& stream) noexcept
+  {
+    return stream.read(byte_order, sensor_id, value, samples, label);
+  }
+
+  bool operator==(const Telemetry&) const = default;
+};
+
+std::endian byte_order_of(const bytepack::buffer_view& buffer)
+{
+  return buffer.as<std::uint8_t>()[0] == 1 ? std::endian::little : std::endian::big;
+}
+
+} // namespace
+
+TEST_CASE("Runtime endianness dispatch - decode with the endianness announced in the header")
+{
+  const Telemetry big_message{ 0, 0x1234, 1.5, { 1, -2, 3 }, "big" };
+  const Telemetry little_message{ 1, 0x1234, 1.5, { 1, -2, 3 }, "little" };
+
+  bytepack::binary_stream<std::endian::big> big_stream(128);
+  REQUIRE(big_message.serialize(big_stream));
+  bytepack::binary_stream<std::endian::little> little_stream(128);
+  REQUIRE(little_message.serialize(little_stream));
+
+  // The same call site decodes both
+  for (const auto& [buffer, expected] : { std::pair{ big_stream.data(), big_message },
+                                          std::pair{ little_stream.data(), little_message } }) {
+    Telemetry decoded{};
+    const bool result = bytepack::dispatch_endian(byte_order_of(buffer), buffer,
+                                                  [&](auto& stream) { return decoded.deserialize(stream); });
+    REQUIRE(result);
+    REQUIRE(decoded == expected);
+  }
+
+  const auto big_bytes = big_stream.data().as<std::uint8_t>();
+  REQUIRE(big_bytes[1] == 0x12);
+  REQUIRE(big_bytes[2] == 0x34);
+  const auto little_bytes = little_stream.data().as<std::uint8_t>();
+  REQUIRE(little_bytes[1] == 0x34);
+  REQUIRE(little_bytes[2] == 0x12);
+}
+
+TEST_CASE("Runtime endianness dispatch - serialize and return values")
+{
+  const Telemetry message{ 1, 7, -0.25, { 42 }, "reply" };
+  std::array<std::uint8_t, 64> buffer{};
+
+  const std::size_t size = bytepack::dispatch_endian(std::endian::little, bytepack::buffer_view(buffer),
+                                                     [&](auto& stream) -> std::size_t {
+                                                       return message.serialize(stream) ? stream.data().size() : 0;
+                                                     });
+  REQUIRE(size == 1 + 2 + 8 + (4 + 4) + (4 + 5));
+  REQUIRE(buffer[1] == 7);
+
+  bytepack::binary_stream<std::endian::little> stream{ bytepack::buffer_view(buffer.data(), size) };
+  Telemetry decoded{};
+  REQUIRE(decoded.deserialize(stream));
+  REQUIRE(decoded == message);
+
+  // Errors are reported by the stream as usual
+  const auto error = bytepack::dispatch_endian(std::endian::big, bytepack::buffer_view(buffer.data(), 2),
+                                               [&](auto& s) {
+                                                 static_cast<void>(decoded.deserialize(s));
+                                                 return s.error().code;
+                                               });
+  REQUIRE(error == bytepack::error_code::buffer_overflow);
+}
+
+TEST_CASE("Runtime endianness dispatch - immutable buffers")
+{
+  // byte order flag, sensor id 0x1234 (little-endian)
+  static constexpr std::uint8_t packet[]{ 0x01, 0x34, 0x12 };
+
+  std::uint16_t sensor_id{};
+  const bool result = bytepack::dispatch_endian(std::endian::little, bytepack::const_buffer_view(packet),
+                                                [&](auto& reader) {
+                                                  std::uint8_t byte_order{};
+                                                  return reader.read(byte_order, sensor_id);
+                                                });
+  REQUIRE(result);
+  REQUIRE(sensor_id == 0x1234);
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+TEST_CASE("Error handling - error code and offset of the first failure")
+{
+  bytepack::binary_stream stream(10);
+  REQUIRE_FALSE(stream.error());
+
+  REQUIRE(stream.write(std::uint32_t{ 1 }));
+  REQUIRE_FALSE(stream.write(std::uint64_t{ 2 }));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.error().offset == 4);
+
+  // Default mode: later calls are still performed, the first error is kept
+  REQUIRE(stream.write(std::uint16_t{ 3 }));
+  REQUIRE_FALSE(stream.write<std::uint8_t>(std::string(300, 'x')));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.error().offset == 4);
+
+  stream.reset();
+  REQUIRE_FALSE(stream.error());
+  REQUIRE_FALSE(stream.write<std::uint8_t>(std::string(300, 'x')));
+  REQUIRE(stream.error().code == bytepack::error_code::size_overflow);
+  REQUIRE(stream.error().offset == 0);
+}
+
+TEST_CASE("Error handling - read errors")
+{
+  // Invalid presence byte of std::optional at offset 2
+  std::uint8_t data[8]{ 0x00, 0x01, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  bytepack::binary_stream stream(bytepack::buffer_view{ data });
+
+  std::uint16_t value{};
+  std::optional<std::uint8_t> optional{};
+  REQUIRE(stream.read(value));
+  REQUIRE_FALSE(stream.read(optional));
+  REQUIRE(stream.error().code == bytepack::error_code::invalid_value);
+  REQUIRE(stream.error().offset == 2);
+
+  // Null terminator not found
+  std::string str{};
+  std::uint8_t no_terminator[4]{ 'a', 'b', 'c', 'd' };
+  bytepack::binary_stream stream2(bytepack::buffer_view{ no_terminator });
+  REQUIRE_FALSE(stream2.read<bytepack::StringMode::NullTerm>(str));
+  REQUIRE(stream2.error().code == bytepack::error_code::missing_terminator);
+
+  // Fewer elements than the given fixed size
+  bytepack::binary_stream stream3(64);
+  REQUIRE_FALSE(stream3.write<4>(std::vector<int>{ 1, 2 }));
+  REQUIRE(stream3.error().code == bytepack::error_code::invalid_size);
+}
+
+TEST_CASE("Error handling - sticky mode (big-endian)")
+{
+  struct SensorData
+  {
+    std::int64_t timestamp;
+    double value;
+    char sensor_id[16];
+    std::string location;
+
+    void serialize(bytepack::binary_stream<>& stream) const
+    {
+      // No checks between fields
+      stream.write(timestamp);
+      stream.write(value);
+      stream.write(sensor_id);
+      stream.write(location);
+    }
+
+    void deserialize(bytepack::binary_stream<>& stream)
+    {
+      stream.read(timestamp);
+      stream.read(value);
+      stream.read(sensor_id);
+      stream.read(location);
+    }
+  };
+
+  const SensorData sensor{ 1701037875, 23.6, "Sensor-001", "substation-4" };
+
+  // Not enough space for the sensor id: later fields are not written
+  bytepack::binary_stream small(20, bytepack::ErrorMode::Sticky);
+  sensor.serialize(small);
+  REQUIRE(small.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(small.error().offset == 16);
+  REQUIRE(small.data().size() == 16);
+  REQUIRE_FALSE(small.write(std::uint8_t{ 1 })); // fits, but the stream has failed
+
+  bytepack::binary_stream stream(128, bytepack::ErrorMode::Sticky);
+  sensor.serialize(stream);
+  REQUIRE_FALSE(stream.error());
+
+  // Truncated message: fields after the failure keep their values
+  bytepack::binary_stream reader(bytepack::buffer_view(stream.data().as<std::uint8_t>(), 30),
+                                 bytepack::ErrorMode::Sticky);
+  SensorData sensor_{ 0, 0.0, "unchanged", "unchanged" };
+  sensor_.deserialize(reader);
+  REQUIRE(reader.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(reader.error().offset == 16);
+  REQUIRE(sensor_.timestamp == sensor.timestamp);
+  REQUIRE(sensor_.value == sensor.value);
+  REQUIRE_THAT(sensor_.sensor_id, Catch::Matchers::Equals("unchanged"));
+  REQUIRE(sensor_.location == "unchanged");
+
+  // reset() clears the error state
+  reader.reset();
+  REQUIRE_FALSE(reader.error());
+  std::int64_t timestamp{};
+  REQUIRE(reader.read(timestamp));
+  REQUIRE(timestamp == sensor.timestamp);
+}
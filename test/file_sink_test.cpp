@@ -0,0 +1,218 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/file_sink.hpp>
+
+#include "test_records.hpp"
+
+#if !defined(_WIN32)
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+namespace {
+
+using bytepack_test::test_record;
+
+std::vector<std::uint8_t> read_file(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Decodes consecutive records and returns their numbers (stops at the first invalid record)
+std::vector<std::uint64_t> read_numbers(std::vector<std::uint8_t>& content)
+{
+  std::vector<std::uint64_t> numbers;
+  bytepack::binary_stream stream(bytepack::buffer_view(content.data(), content.size()));
+  test_record record{};
+  while (record.deserialize(stream) && record == test_record::make(record.number)) {
+    numbers.push_back(record.number);
+  }
+  return numbers;
+}
+
+// Appends the records and returns the number of accepted records
+template<std::endian E = std::endian::big>
+std::size_t append_records(bytepack::file_sink& sink, const std::uint64_t first, const std::uint64_t count)
+{
+  std::size_t accepted = 0;
+  for (std::uint64_t i = first; i < first + count; ++i) {
+    const test_record record = test_record::make(i);
+    if (sink.append<E>([&](auto& stream) { return record.serialize(stream); })) {
+      ++accepted;
+    }
+  }
+  return accepted;
+}
+
+} // namespace
+
+TEST_CASE("File sink - records are written in order by the background thread")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_file_sink_test.log";
+
+  bytepack::file_sink_options options;
+  options.buffer_size = 4096;
+  options.buffer_count = 3;
+  options.sync = bytepack::sync_policy::every_write;
+
+  constexpr std::uint64_t record_count = 20000;
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    REQUIRE(sink.is_open());
+    REQUIRE(append_records(sink, 0, record_count) == record_count);
+
+    // Larger than a buffer
+    const test_record large{ 0, std::string(5000, 'y') };
+    REQUIRE_FALSE(sink.append([&](auto& stream) { return large.serialize(stream); }));
+
+    REQUIRE(sink.close());
+    REQUIRE_FALSE(sink.is_open());
+    REQUIRE(sink.error() == 0);
+    REQUIRE(sink.dropped_records() == 0);
+    REQUIRE(sink.bytes_written() == std::filesystem::file_size(path));
+  }
+
+  auto content = read_file(path);
+  std::vector<std::uint64_t> expected(record_count);
+  std::iota(expected.begin(), expected.end(), 0U);
+  REQUIRE(read_numbers(content) == expected);
+
+  // Pre-serialized records, appended to the existing file
+  options.append_to_file = true;
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    bytepack::binary_stream stream(64);
+    REQUIRE(test_record::make(record_count).serialize(stream));
+    REQUIRE(sink.append(stream.data()));
+  } // closed by the destructor
+
+  content = read_file(path);
+  REQUIRE(read_numbers(content).back() == record_count);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("File sink - drop back-pressure policy")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_file_sink_drop_test.log";
+
+  bytepack::file_sink_options options;
+  options.buffer_size = 256;
+  options.backpressure = bytepack::backpressure_policy::drop;
+  options.sync = bytepack::sync_policy::none;
+
+  constexpr std::uint64_t record_count = 50000;
+  std::vector<std::uint64_t> accepted;
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    for (std::uint64_t i = 0; i < record_count; ++i) {
+      const test_record record = test_record::make(i);
+      if (sink.append([&](auto& stream) { return record.serialize(stream); })) {
+        accepted.push_back(i);
+      }
+    }
+    REQUIRE(sink.close());
+    REQUIRE(accepted.size() + sink.dropped_records() == record_count);
+  }
+
+  auto content = read_file(path);
+  REQUIRE(read_numbers(content) == accepted);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("File sink - direct I/O")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_file_sink_direct_test.log";
+
+  bytepack::file_sink_options options;
+  options.buffer_size = 10000; // rounded up to 4 KiB blocks with direct I/O
+  options.direct_io = true;
+
+  constexpr std::uint64_t record_count = 5000;
+  {
+    // Falls back to the page cache if the file system (e.g. tmpfs) does not support O_DIRECT
+    bytepack::file_sink sink(path.c_str(), options);
+    REQUIRE(sink.is_open());
+    REQUIRE(append_records(sink, 0, record_count) == record_count);
+    REQUIRE(sink.close());
+  }
+
+  auto content = read_file(path);
+  REQUIRE(read_numbers(content).size() == record_count);
+
+  // A record of a whole buffer (3 blocks) after a partial block, which is moved over to the next buffer
+  const std::string small(100, 's');
+  const std::string whole(3 * bytepack::file_sink::direct_io_block_size, 'w');
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    REQUIRE(sink.append(bytepack::const_buffer_view(small)));
+    REQUIRE(sink.append(bytepack::const_buffer_view(whole)));
+    REQUIRE(sink.close());
+  }
+  REQUIRE(std::filesystem::file_size(path) == small.size() + whole.size());
+
+  // Appending to a file that does not end on a block boundary continues through the page cache
+  options.append_to_file = true;
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    REQUIRE(sink.is_open());
+    REQUIRE_FALSE(sink.direct_io());
+    REQUIRE(sink.append(bytepack::const_buffer_view(small)));
+    REQUIRE(sink.close());
+  }
+  REQUIRE(std::filesystem::file_size(path) == 2 * small.size() + whole.size());
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("File sink - only a full buffer is retried")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_file_sink_retry_test.log";
+
+  bytepack::file_sink_options options;
+  options.buffer_size = 256;
+  {
+    bytepack::file_sink sink(path.c_str(), options);
+    REQUIRE(sink.append(bytepack::const_buffer_view(std::string(200, 'a'))));
+
+    // Size field too small for the string: fails once, without switching buffers
+    int calls = 0;
+    REQUIRE_FALSE(sink.append([&](auto& stream) {
+      ++calls;
+      return stream.template write<std::uint8_t>(std::string(300, 'b'));
+    }));
+    REQUIRE(calls == 1);
+
+    // Failure without a stream error (e.g. a validation in the serializer)
+    calls = 0;
+    REQUIRE_FALSE(sink.append([&](auto&) { return ++calls < 0; }));
+    REQUIRE(calls == 1);
+
+    // Does not fit in the rest of the buffer: serialized again into the next one
+    calls = 0;
+    REQUIRE(sink.append([&](auto& stream) {
+      ++calls;
+      return stream.write(std::string(100, 'c'));
+    }));
+    REQUIRE(calls == 2);
+    REQUIRE(sink.close());
+  }
+  REQUIRE(std::filesystem::file_size(path) == 200 + 4 + 100);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("File sink - open failure")
+{
+  bytepack::file_sink sink("/nonexistent_bytepack_directory/file.log");
+  REQUIRE_FALSE(sink.is_open());
+  REQUIRE(sink.error() != 0);
+  REQUIRE_FALSE(sink.append([](auto& stream) { return stream.write(std::uint8_t{ 1 }); }));
+  REQUIRE_FALSE(sink.close());
+}
+
+#endif
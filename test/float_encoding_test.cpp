@@ -0,0 +1,136 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+#include <limits>
+
+TEST_CASE("Float encoding - float16 conversion")
+{
+  using bytepack::float16;
+
+  REQUIRE(float16::encode(0.0f) == 0x0000);
+  REQUIRE(float16::encode(-0.0f) == 0x8000);
+  REQUIRE(float16::encode(1.0f) == 0x3C00);
+  REQUIRE(float16::encode(-2.0f) == 0xC000);
+  REQUIRE(float16::encode(65504.0f) == 0x7BFF);
+  REQUIRE(float16::encode(65520.0f) == 0x7C00); // rounds to infinity
+  REQUIRE(float16::encode(std::numeric_limits<float>::infinity()) == 0x7C00);
+  REQUIRE(float16::encode(0x1p-24f) == 0x0001); // smallest subnormal
+  REQUIRE(float16::encode(0x1p-14f) == 0x0400); // smallest normal
+  REQUIRE(float16::encode(0x1p-26f) == 0x0000);
+  REQUIRE(float16::encode(1.0f + 0x1p-11f) == 0x3C00); // tie, rounds to even
+  REQUIRE(float16::encode(1.0f + 0x1p-10f + 0x1p-11f) == 0x3C02);
+
+  REQUIRE(float16::decode<float>(0x3C00) == 1.0f);
+  REQUIRE(float16::decode<float>(0xC000) == -2.0f);
+  REQUIRE(float16::decode<float>(0x0001) == 0x1p-24f);
+  REQUIRE(float16::decode<double>(0x7BFF) == 65504.0);
+  REQUIRE(float16::decode<float>(0x7C00) == std::numeric_limits<float>::infinity());
+  REQUIRE(std::isnan(float16::decode<float>(float16::encode(std::numeric_limits<float>::quiet_NaN()))));
+
+  // All finite half values round trip exactly
+  std::size_t mismatches = 0;
+  for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+    const auto half = static_cast<std::uint16_t>(bits);
+    if ((half & 0x7C00) != 0x7C00 && float16::encode(float16::decode<float>(half)) != half) {
+      ++mismatches;
+    }
+  }
+  REQUIRE(mismatches == 0);
+
+  static_assert(float16::encode(1.0f) == 0x3C00);
+  static_assert(float16::decode<float>(0x3C00) == 1.0f);
+}
+
+TEST_CASE("Float encoding - bfloat16 and fixed_point conversion")
+{
+  using bytepack::bfloat16;
+  REQUIRE(bfloat16::encode(1.0f) == 0x3F80);
+  REQUIRE(bfloat16::encode(-3.5f) == 0xC060);
+  REQUIRE(bfloat16::encode(1.0f + 0x1p-8f) == 0x3F80); // tie, rounds to even
+  REQUIRE(bfloat16::encode(1.0f + 0x1p-7f + 0x1p-8f) == 0x3F82);
+  REQUIRE(bfloat16::decode<float>(0x3F80) == 1.0f);
+  REQUIRE(std::isnan(bfloat16::decode<float>(bfloat16::encode(std::numeric_limits<float>::quiet_NaN()))));
+
+  using centi = bytepack::fixed_point<std::int16_t, 100>;
+  REQUIRE(centi::encode(12.345f) == 1235);
+  REQUIRE(centi::encode(-12.345) == -1235);
+  REQUIRE(centi::encode(1000.0f) == std::numeric_limits<std::int16_t>::max()); // saturated
+  REQUIRE(centi::encode(-1000.0f) == std::numeric_limits<std::int16_t>::min());
+  REQUIRE(centi::encode(std::numeric_limits<float>::quiet_NaN()) == 0);
+  REQUIRE(centi::decode<double>(1235) == Approx(12.35));
+
+  using unsigned_milli = bytepack::fixed_point<std::uint16_t, 1000>;
+  REQUIRE(unsigned_milli::encode(-1.0f) == 0);
+  REQUIRE(unsigned_milli::encode(1.5f) == 1500);
+}
+
+TEST_CASE("Float encoding - stream serialization")
+{
+  float voltage[3] = { 230.5f, 229.75f, 231.25f };
+  std::array<float, 3> current = { 10.5f, 11.25f, 9.75f };
+  double power_factor = 0.95;
+  float temperature = -12.34f;
+  std::vector<float> samples = { 0.5f, -0.25f, 1.75f, 8.0f };
+
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write<bytepack::float16>(voltage));
+  REQUIRE(stream.write<bytepack::bfloat16>(current));
+  REQUIRE(stream.write<bytepack::fixed_point<std::uint16_t, 10000>>(power_factor));
+  REQUIRE(stream.write<bytepack::fixed_point<std::int16_t, 100>>(temperature));
+  REQUIRE(stream.write<bytepack::float16, std::uint8_t>(samples));
+  REQUIRE(stream.data().size() == 6 + 6 + 2 + 2 + (1 + 8));
+
+  // Big-endian wire values
+  const auto* bytes = static_cast<const std::uint8_t*>(stream.data().as<void>());
+  REQUIRE(bytes[0] == 0x5B); // 230.5 = 0x5B34
+  REQUIRE(bytes[1] == 0x34);
+
+  float voltage_r[3]{};
+  std::array<float, 3> current_r{};
+  double power_factor_r{};
+  float temperature_r{};
+  std::vector<float> samples_r;
+
+  bytepack::binary_stream read_stream(stream.data());
+  REQUIRE(read_stream.read<bytepack::float16>(voltage_r));
+  REQUIRE(read_stream.read<bytepack::bfloat16>(current_r));
+  REQUIRE(read_stream.read<bytepack::fixed_point<std::uint16_t, 10000>>(power_factor_r));
+  REQUIRE(read_stream.read<bytepack::fixed_point<std::int16_t, 100>>(temperature_r));
+  REQUIRE(read_stream.read<bytepack::float16, std::uint8_t>(samples_r));
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    REQUIRE(voltage_r[i] == voltage[i]);
+    REQUIRE(current_r[i] == current[i]);
+  }
+  REQUIRE(power_factor_r == Approx(0.95));
+  REQUIRE(temperature_r == Approx(-12.34f));
+  REQUIRE(samples_r == samples);
+}
+
+TEST_CASE("Float encoding - little-endian and overflow")
+{
+  bytepack::binary_stream<std::endian::little> stream(5);
+  REQUIRE(stream.write<bytepack::float16>(1.0f));
+  const auto* bytes = static_cast<const std::uint8_t*>(stream.data().as<void>());
+  REQUIRE(bytes[0] == 0x00);
+  REQUIRE(bytes[1] == 0x3C);
+
+  // Arrays are checked as a whole before anything is written
+  std::array<float, 2> values = { 1.0f, 2.0f };
+  REQUIRE_FALSE(stream.write<bytepack::bfloat16>(values));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.error().offset == 2);
+  REQUIRE(stream.data().size() == 2);
+
+  std::vector<float> vector = { 1.0f };
+  REQUIRE_FALSE(stream.write<bytepack::float16>(vector));
+  REQUIRE(stream.data().size() == 2);
+
+  // Element count larger than the remaining bytes
+  std::uint8_t buffer[] = { 0x00, 0x00, 0x00, 0x05, 0x3C, 0x00 };
+  bytepack::binary_stream read_stream{ bytepack::buffer_view(buffer) };
+  std::vector<float> result;
+  REQUIRE_FALSE(read_stream.read<bytepack::float16>(result));
+  REQUIRE(result.empty());
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+#include <thread>
+
+namespace {
+
+using counted_stream = bytepack::binary_stream<std::endian::big, bytepack::stream_statistics>;
+
+} // namespace
+
+TEST_CASE("Instrumentation - disabled by default")
+{
+  static_assert(sizeof(bytepack::binary_stream<>) == sizeof(bytepack::binary_stream<std::endian::little>));
+  static_assert(bytepack::no_instrumentation::enabled == false);
+
+  bytepack::stream_statistics::clear();
+  {
+    bytepack::binary_stream stream(8);
+    stream.set_message_type(1);
+    REQUIRE(stream.write(std::uint32_t{ 1 }));
+    REQUIRE_FALSE(stream.write(std::uint64_t{ 2 }));
+  }
+  REQUIRE(bytepack::stream_statistics::snapshot().cycles == 0);
+}
+
+TEST_CASE("Instrumentation - bytes, utilization and message sizes")
+{
+  bytepack::stream_statistics::clear();
+
+  counted_stream stream(100);
+  stream.set_message_type(10);
+  REQUIRE(stream.write(std::uint64_t{ 1 }, std::string("hello")));
+  stream.reset();
+
+  stream.set_message_type(10);
+  REQUIRE(stream.write(std::uint32_t{ 2 }));
+  stream.reset();
+
+  REQUIRE(stream.write(std::array<std::uint8_t, 50>{}));
+  counted_stream reader(stream.data());
+  std::array<std::uint8_t, 20> partial{};
+  REQUIRE(reader.read(partial));
+  reader.set_message_type(11);
+  reader.reset();
+
+  // The last cycle of `stream` is recorded when it is reset or destroyed
+  const auto stats = bytepack::stream_statistics::snapshot();
+  REQUIRE(stats.cycles == 3);
+  REQUIRE(stats.bytes_written == 17 + 4);
+  REQUIRE(stats.bytes_read == 20);
+  REQUIRE(stats.peak_bytes_written == 17);
+  REQUIRE(stats.peak_utilization == Approx(0.17));
+  REQUIRE(stats.bulk_copies == 3);
+  REQUIRE(stats.bulk_bytes == 5 + 50 + 20);
+  REQUIRE(stats.message_sizes.size() == 2);
+  REQUIRE(stats.message_sizes.find(10) != nullptr);
+  REQUIRE(stats.message_sizes.find(10)->count == 2);
+  REQUIRE(stats.message_sizes.find(10)->total_bytes == 21);
+  REQUIRE(stats.message_sizes.find(10)->max_bytes == 17);
+  REQUIRE(stats.message_sizes.find(11) != nullptr);
+  REQUIRE(stats.message_sizes.find(11)->total_bytes == 20);
+  REQUIRE(stats.message_sizes.find(12) == nullptr);
+
+  stream.reset();
+  REQUIRE(bytepack::stream_statistics::snapshot().peak_utilization == Approx(0.5));
+}
+
+TEST_CASE("Instrumentation - failures by error code and function")
+{
+  bytepack::stream_statistics::clear();
+  {
+    counted_stream stream(4);
+    REQUIRE_FALSE(stream.write(std::uint64_t{ 1 }));
+    REQUIRE_FALSE(stream.write(std::string("abcdef")));
+    REQUIRE_FALSE(stream.write<std::uint8_t>(std::string(300, 'x')));
+
+    std::uint8_t buffer[] = { 0x02 };
+    counted_stream reader{ bytepack::buffer_view(buffer) };
+    std::optional<std::uint8_t> value;
+    REQUIRE_FALSE(reader.read(value));
+  }
+
+  const auto stats = bytepack::stream_statistics::snapshot();
+  REQUIRE(stats.failure_count(bytepack::error_code::buffer_overflow) == 2);
+  REQUIRE(stats.failure_count(bytepack::error_code::size_overflow) == 1);
+  REQUIRE(stats.failure_count(bytepack::error_code::invalid_value) == 1);
+  REQUIRE(stats.failures_by_function.size() >= 3);
+  REQUIRE(stats.failures_by_function.dropped == 0);
+}
+
+TEST_CASE("Instrumentation - message type table has a fixed capacity")
+{
+  bytepack::stream_statistics::clear();
+  constexpr std::uint32_t type_count = bytepack::stream_statistics::max_message_types + 6;
+  {
+    counted_stream stream(16);
+    for (std::uint32_t type = 0; type < type_count; ++type) {
+      stream.set_message_type(type);
+      static_cast<void>(stream.write(type));
+      stream.reset();
+    }
+  }
+
+  auto stats = bytepack::stream_statistics::snapshot();
+  REQUIRE(stats.cycles == type_count);
+  REQUIRE(stats.message_sizes.size() == bytepack::stream_statistics::max_message_types);
+  REQUIRE(stats.message_sizes.dropped == 6);
+  REQUIRE(stats.message_sizes.find(type_count - 1) == nullptr);
+
+  // Merging keeps the types that fit and adds up the dropped updates
+  stats += bytepack::stream_statistics::snapshot();
+  REQUIRE(stats.message_sizes.find(0)->count == 2);
+  REQUIRE(stats.message_sizes.dropped == 12);
+}
+
+TEST_CASE("Instrumentation - counters are thread-local and can be merged")
+{
+  bytepack::stream_statistics::clear();
+  {
+    counted_stream stream(16);
+    REQUIRE(stream.write(std::uint32_t{ 1 }));
+  }
+
+  // Catch2 assertions are not thread-safe: the worker only records its results
+  bytepack::stream_statistics::counters other_thread;
+  bool other_thread_written = false;
+  std::thread worker([&other_thread, &other_thread_written] {
+    {
+      counted_stream stream(16);
+      other_thread_written = stream.write(std::uint64_t{ 1 });
+    }
+    other_thread = bytepack::stream_statistics::snapshot();
+  });
+  worker.join();
+  REQUIRE(other_thread_written);
+
+  auto total = bytepack::stream_statistics::snapshot();
+  REQUIRE(total.bytes_written == 4);
+  REQUIRE(other_thread.bytes_written == 8);
+
+  total += other_thread;
+  REQUIRE(total.cycles == 2);
+  REQUIRE(total.bytes_written == 12);
+  REQUIRE(total.peak_bytes_written == 8);
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/mapped_file.hpp>
+
+#include "test_records.hpp"
+
+#if !defined(_WIN32)
+
+#include <filesystem>
+
+namespace {
+
+using bytepack_test::test_record;
+
+// Reads all records and returns their number if each record `i` matches test_record::make(i)
+template<std::endian E = std::endian::big>
+std::size_t count_records(bytepack::mapped_file_reader& reader, bool& complete)
+{
+  std::size_t count = 0;
+  std::size_t mismatches = 0;
+  test_record record{};
+  complete = reader.for_each_record<E>([&](auto& stream) {
+    if (!record.deserialize(stream)) {
+      return false;
+    }
+    if (record != test_record::make(count++)) {
+      ++mismatches;
+    }
+    return true;
+  });
+  return mismatches == 0 ? count : 0;
+}
+
+} // namespace
+
+TEST_CASE("Mapped file - write, grow and read back")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_mapped_file_test.bin";
+  constexpr std::uint64_t record_count = 10000;
+
+  {
+    bytepack::mapped_file_writer writer(path.c_str(), 64 * 1024); // grows several times
+    REQUIRE(writer.is_open());
+    std::size_t written = 0;
+    for (std::uint64_t i = 0; i < record_count; ++i) {
+      const test_record record = test_record::make(i);
+      if (writer.append([&](auto& stream) { return record.serialize(stream); })) {
+        ++written;
+      }
+    }
+    REQUIRE(written == record_count);
+
+    // Does not fit after growing once
+    const test_record large{ 0, std::string(160000, 'x') };
+    REQUIRE_FALSE(writer.append([&](auto& stream) { return large.serialize(stream); }));
+    REQUIRE(writer.sync());
+    REQUIRE(writer.close());
+  }
+  const auto file_size = std::filesystem::file_size(path);
+
+  SECTION("whole file")
+  {
+    bytepack::mapped_file_reader reader(path.c_str());
+    REQUIRE(reader.is_open());
+    REQUIRE(reader.file_size() == file_size);
+    REQUIRE(reader.view().size() == file_size);
+    REQUIRE(reader.is_last_window());
+
+    bool complete = false;
+    REQUIRE(count_records(reader, complete) == record_count);
+    REQUIRE(complete);
+    REQUIRE(reader.offset() == file_size);
+  }
+
+  SECTION("small windows")
+  {
+    bytepack::mapped_file_reader reader(path.c_str(), 4096, bytepack::access_pattern::will_need);
+    REQUIRE(reader.view().size() == 4096);
+    REQUIRE_FALSE(reader.is_last_window());
+
+    bool complete = false;
+    REQUIRE(count_records(reader, complete) == record_count);
+    REQUIRE(complete);
+  }
+
+  SECTION("window at an offset")
+  {
+    bytepack::mapped_file_reader reader(path.c_str(), 0, bytepack::access_pattern::random);
+    const std::uint64_t offset = 8 + 4; // second record
+    REQUIRE(reader.map(offset));
+    REQUIRE(reader.offset() == offset);
+    REQUIRE(reader.view().size() == file_size - offset);
+
+    bytepack::binary_reader stream(reader.view());
+    test_record record{};
+    REQUIRE(record.deserialize(stream));
+    REQUIRE(record == test_record::make(1));
+    REQUIRE_FALSE(reader.map(file_size));
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Mapped file - truncated and empty files")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_mapped_file_truncated_test.bin";
+  {
+    bytepack::mapped_file_writer writer(path.c_str());
+    const test_record record = test_record::make(0);
+    REQUIRE(writer.append([&](auto& stream) { return record.serialize(stream); }));
+    std::uint8_t truncated[]{ 0x00, 0x01 };
+    REQUIRE(writer.append(bytepack::buffer_view(truncated))); // truncated record
+    REQUIRE(writer.size() == 8 + 4 + 2);
+  }
+
+  {
+    bytepack::mapped_file_reader reader(path.c_str(), 4096);
+    bool complete = true;
+    REQUIRE(count_records(reader, complete) == 1);
+    REQUIRE_FALSE(complete);
+    REQUIRE(reader.offset() == 12); // the failing record
+  }
+
+  {
+    bytepack::mapped_file_writer writer(path.c_str());
+  }
+  REQUIRE(std::filesystem::file_size(path) == 0);
+  {
+    bytepack::mapped_file_reader reader(path.c_str());
+    REQUIRE(reader.is_open());
+    bool complete = false;
+    REQUIRE(count_records(reader, complete) == 0);
+    REQUIRE(complete);
+  }
+
+  bytepack::mapped_file_reader missing("/nonexistent_bytepack_directory/file.bin");
+  REQUIRE_FALSE(missing.is_open());
+  REQUIRE(missing.error() != 0);
+
+  std::filesystem::remove(path);
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/message_batch.hpp>
+
+#include "test_records.hpp"
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+using bytepack_test::test_record;
+
+TEST_CASE("Message batch - messages are serialized back-to-back")
+{
+  bytepack::message_batch batch(1024);
+  REQUIRE(batch.empty());
+
+  for (std::uint32_t i = 0; i < 10; ++i) {
+    const test_record record = test_record::make(i);
+    REQUIRE(batch.add([&](auto& stream) { return record.serialize(stream); }));
+  }
+  REQUIRE(batch.size() == 10);
+  REQUIRE(batch.offset(0) == 0);
+
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    REQUIRE(batch.offset(i) == total);
+    total += batch.message(i).size();
+
+    bytepack::binary_stream stream(batch.message(i));
+    test_record record{};
+    REQUIRE(record.deserialize(stream));
+    REQUIRE(record == test_record::make(i));
+  }
+  REQUIRE(batch.data().size() == total);
+
+  // Pre-serialized messages
+  bytepack::binary_stream header(8);
+  REQUIRE(header.write(std::uint32_t{ 0xCAFE }));
+  REQUIRE(batch.add(header.data()));
+  REQUIRE(batch.size() == 11);
+  REQUIRE(batch.message(10).size() == 4);
+
+  batch.clear();
+  REQUIRE(batch.empty());
+  REQUIRE(batch.data().size() == 0);
+}
+
+TEST_CASE("Message batch - full batch")
+{
+  bytepack::message_batch<std::endian::little> batch(16);
+  REQUIRE(batch.add([](auto& stream) { return stream.write(std::uint64_t{ 1 }); }));
+  REQUIRE(batch.add([](auto& stream) { return stream.write(std::uint32_t{ 2 }); }));
+  REQUIRE_FALSE(batch.add([](auto& stream) { return stream.write(std::uint64_t{ 3 }); }));
+  REQUIRE(batch.size() == 2);
+
+  std::array<std::uint8_t, 8> bytes{};
+  REQUIRE_FALSE(batch.add(bytepack::buffer_view(bytes)));
+  REQUIRE(batch.add(bytepack::buffer_view(bytes.data(), 4)));
+  REQUIRE(batch.data().size() == 16);
+}
+
+#if defined(__linux__)
+TEST_CASE("Message batch - sendmmsg/recvmmsg over loopback")
+{
+  const int receiver = ::socket(AF_INET, SOCK_DGRAM, 0);
+  const int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+  REQUIRE(receiver >= 0);
+  REQUIRE(sender >= 0);
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  REQUIRE(::bind(receiver, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+  socklen_t address_length = sizeof(address);
+  REQUIRE(::getsockname(receiver, reinterpret_cast<sockaddr*>(&address), &address_length) == 0);
+
+  timeval timeout{ 2, 0 };
+  REQUIRE(::setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+
+  constexpr std::uint32_t message_count = 48;
+  bytepack::message_batch batch(16 * 1024);
+  for (std::uint32_t i = 0; i < message_count; ++i) {
+    const test_record record = test_record::make(i);
+    REQUIRE(batch.add([&](auto& stream) { return record.serialize(stream); }));
+  }
+
+  const auto headers = batch.mmsghdrs(reinterpret_cast<const sockaddr*>(&address), address_length);
+  REQUIRE(headers.size() == message_count);
+  REQUIRE(headers[3].msg_hdr.msg_iov->iov_len == batch.message(3).size());
+
+  REQUIRE(batch.send(sender, reinterpret_cast<const sockaddr*>(&address), address_length) == message_count);
+
+  bytepack::receive_batch received(32, 64);
+  std::uint32_t expected = 0;
+  while (expected < message_count) {
+    const int count = received.receive(receiver);
+    REQUIRE(count > 0);
+    REQUIRE(received.size() == static_cast<std::size_t>(count));
+    for (std::size_t i = 0; i < received.size(); ++i) {
+      REQUIRE_FALSE(received.truncated(i));
+      REQUIRE(received.source(i).ss_family == AF_INET);
+
+      bytepack::binary_stream stream(received.message(i));
+      test_record record{};
+      REQUIRE(record.deserialize(stream));
+      REQUIRE(record == test_record::make(expected++));
+    }
+  }
+
+  // Truncated datagrams
+  bytepack::receive_batch small(4, 8);
+  batch.clear();
+  REQUIRE(batch.add([](auto& stream) { return stream.write(std::uint64_t{ 1 }, std::uint64_t{ 2 }); }));
+  REQUIRE(batch.mmsghdrs().size() == 1);
+  REQUIRE(batch.send(sender, reinterpret_cast<const sockaddr*>(&address), address_length) == 1);
+  REQUIRE(small.receive(receiver) == 1);
+  REQUIRE(small.truncated(0));
+  REQUIRE(small.message(0).size() == 8);
+
+  ::close(sender);
+  ::close(receiver);
+}
+#endif
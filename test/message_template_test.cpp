@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+// Simple additive checksum to keep the test independent of any CRC library
+std::uint32_t byte_sum(const std::uint8_t* data, const std::size_t size)
+{
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+} // namespace
+
+TEST_CASE("Message template - patch mutable fields in place (big-endian)")
+{
+  const std::uint16_t message_id = 0x0A0B;
+  const std::string device_name = "transformer-7";
+
+  bytepack::message_template tmpl(128);
+  bytepack::field_slot<std::uint32_t> sequence;
+  bytepack::field_slot<std::int64_t> timestamp;
+  bytepack::field_slot<float[3]> voltage;
+  bytepack::field_slot<std::uint32_t> checksum;
+
+  REQUIRE(tmpl.stream().write(message_id));
+  REQUIRE(tmpl.write_mutable(sequence));
+  REQUIRE(tmpl.write_mutable(timestamp, std::int64_t{ -1 }));
+  REQUIRE(tmpl.stream().write<std::uint8_t>(device_name));
+  REQUIRE(tmpl.write_mutable(voltage));
+  REQUIRE(tmpl.write_mutable(checksum));
+
+  REQUIRE(sequence.offset == 2);
+  REQUIRE(timestamp.offset == 6);
+  REQUIRE(voltage.offset == 15 + device_name.size());
+  REQUIRE(tmpl.data().size() == checksum.offset + sizeof(std::uint32_t));
+
+  for (std::uint32_t seq = 1; seq <= 3; ++seq) {
+    const float voltages[3] = { 230.0f + static_cast<float>(seq), 231.0f, 232.0f };
+    REQUIRE(tmpl.patch(sequence, seq));
+    REQUIRE(tmpl.patch(timestamp, std::int64_t{ 1701037875 } + seq));
+    REQUIRE(tmpl.patch(voltage, voltages));
+    REQUIRE(tmpl.update_checksum(checksum, byte_sum));
+
+    bytepack::binary_stream reader(tmpl.data());
+    std::uint16_t message_id_{};
+    std::uint32_t sequence_{};
+    std::int64_t timestamp_{};
+    std::string device_name_{};
+    float voltages_[3]{};
+    std::uint32_t checksum_{};
+    REQUIRE(reader.read(message_id_, sequence_, timestamp_));
+    REQUIRE(reader.read<std::uint8_t>(device_name_));
+    REQUIRE(reader.read(voltages_, checksum_));
+
+    REQUIRE(message_id_ == message_id);
+    REQUIRE(sequence_ == seq);
+    REQUIRE(timestamp_ == 1701037875 + seq);
+    REQUIRE(device_name_ == device_name);
+    REQUIRE(voltages_[0] == voltages[0]);
+    REQUIRE(checksum_ == byte_sum(tmpl.data().as<std::uint8_t>(), checksum.offset));
+  }
+}
+
+TEST_CASE("Message template - patch a copy (little-endian)")
+{
+  bytepack::message_template<std::endian::little> tmpl(16);
+  bytepack::field_slot<std::uint16_t> counter;
+  REQUIRE(tmpl.stream().write(std::uint8_t{ 0x7E }));
+  REQUIRE(tmpl.write_mutable(counter, std::uint16_t{ 0xFFFF }));
+  REQUIRE(tmpl.stream().write(std::uint8_t{ 0x7F }));
+
+  std::array<std::uint8_t, 4> send_buffer{};
+  bytepack::buffer_view target(send_buffer);
+  REQUIRE(tmpl.copy_to(target));
+
+  bytepack::binary_stream<std::endian::little> out(target);
+  REQUIRE(out.write_field(std::uint16_t{ 0x1234 }, counter.offset));
+  REQUIRE(send_buffer == std::array<std::uint8_t, 4>{ 0x7E, 0x34, 0x12, 0x7F });
+
+  // Template itself is not modified by patching the copy
+  std::uint16_t counter_{};
+  bytepack::binary_stream<std::endian::little> reader(tmpl.data());
+  REQUIRE(reader.read_field(counter_, counter.offset));
+  REQUIRE(counter_ == 0xFFFF);
+
+  // Out of bounds
+  REQUIRE_FALSE(out.write_field(std::uint32_t{ 1 }, 1));
+  REQUIRE_FALSE(tmpl.copy_to(bytepack::buffer_view(send_buffer.data(), 3)));
+  bytepack::field_slot<std::uint16_t> invalid{ 100 };
+  REQUIRE_FALSE(tmpl.patch(invalid, std::uint16_t{ 1 }));
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+enum class Status : std::uint8_t { IDLE, ACTIVE, FAULT };
+
+// timestamp, identifier, serial number, voltages, status
+using TelemetryLayout = bytepack::field_layout<std::int64_t, std::uint32_t, char[12], std::array<float, 3>, Status>;
+
+template<typename View>
+concept has_setter = requires(View view) { view.template set<1>(1U); };
+
+} // namespace
+
+TEST_CASE("Message view - typed getters over a serialized message (big-endian)")
+{
+  const std::int64_t timestamp = 1701037875;
+  const std::uint32_t identifier = 0xA1B2C3D4;
+  char serial_number[12] = "SN-00012345";
+  const std::array<float, 3> voltages = { 229.5f, 230.1f, 231.7f };
+
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(timestamp, identifier, serial_number, voltages, Status::ACTIVE));
+
+  const bytepack::message_view<TelemetryLayout> view(stream.data());
+  REQUIRE(view.is_valid());
+  REQUIRE(view.get<1>() == identifier);
+  REQUIRE(view.get<0>() == timestamp);
+  REQUIRE(view.get<3>() == voltages);
+  REQUIRE(view.get<4>() == Status::ACTIVE);
+
+  char serial_number_[12]{};
+  REQUIRE(view.get<2>(serial_number_));
+  REQUIRE_THAT(serial_number_, Catch::Matchers::Equals(serial_number));
+}
+
+TEST_CASE("Message view - setters write in place (little-endian)")
+{
+  std::array<std::uint8_t, TelemetryLayout::size> buffer{};
+  bytepack::message_view<TelemetryLayout, std::endian::little> view{ bytepack::buffer_view(buffer) };
+
+  REQUIRE(view.set<1>(0x01020304U));
+  REQUIRE(view.set<4>(Status::FAULT));
+  REQUIRE(buffer[8] == 0x04);
+  REQUIRE(buffer[11] == 0x01);
+  REQUIRE(buffer[36] == 2);
+
+  // Same data read sequentially
+  bytepack::binary_stream<std::endian::little> reader{ bytepack::buffer_view(buffer) };
+  std::int64_t timestamp{};
+  std::uint32_t identifier{};
+  REQUIRE(reader.read(timestamp, identifier));
+  REQUIRE(identifier == 0x01020304U);
+
+  // Views are cheap to copy and share the buffer
+  const auto copy = view;
+  REQUIRE(copy.get<1>() == 0x01020304U);
+  REQUIRE(copy.data().size() == TelemetryLayout::size);
+}
+
+TEST_CASE("Message view - read-only view over const data")
+{
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(std::int64_t{ 5 }, 0xCAFEU, "SN-00000001", std::array<float, 3>{ 1.0f, 2.0f, 3.0f },
+                       Status::IDLE));
+  const std::vector<std::uint8_t> packet(stream.data().as<std::uint8_t>(),
+                                         stream.data().as<std::uint8_t>() + stream.data().size());
+
+  const bytepack::const_message_view<TelemetryLayout> view{ bytepack::const_buffer_view(packet.data(),
+                                                                                        packet.size()) };
+  REQUIRE(view.is_valid());
+  REQUIRE(view.get<1>() == 0xCAFEU);
+  REQUIRE(view.get<3>()[2] == 3.0f);
+  REQUIRE(view.data().as<std::uint8_t>() == packet.data());
+
+  // No setters on a read-only view
+  STATIC_REQUIRE_FALSE(has_setter<bytepack::const_message_view<TelemetryLayout>>);
+  STATIC_REQUIRE(has_setter<bytepack::message_view<TelemetryLayout>>);
+}
+
+TEST_CASE("Message view - buffer smaller than layout")
+{
+  std::uint8_t buffer[10]{};
+  bytepack::message_view<TelemetryLayout> view{ bytepack::buffer_view(buffer) };
+  REQUIRE_FALSE(view.is_valid());
+
+  // Fields inside the buffer are still accessible
+  REQUIRE(view.set<0>(std::int64_t{ -1 }));
+  REQUIRE(view.get<0>() == -1);
+
+  REQUIRE_FALSE(view.set<1>(42U));
+  std::uint32_t identifier = 7;
+  REQUIRE_FALSE(view.get<1>(identifier));
+  REQUIRE(identifier == 7);
+  std::array<float, 3> voltages{};
+  REQUIRE_FALSE(view.get<3>(voltages));
+}
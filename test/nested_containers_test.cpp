@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+TEST_CASE("Nested containers - vector of strings and vector of vectors (big-endian)")
+{
+  const std::vector<std::string> names = { "transformer", "", "breaker-01" };
+  const std::vector<std::vector<std::uint16_t>> samples = { { 1, 2, 3 }, {}, { 0xABCD } };
+  const std::vector<std::array<std::int32_t, 2>> points = { { -1, 1 }, { 2, -2 } };
+
+  bytepack::binary_stream stream(256);
+  REQUIRE(stream.write(names));
+  REQUIRE(stream.write<std::uint8_t>(samples));
+  REQUIRE(stream.write(points));
+  REQUIRE(stream.data().size() == (4 + 4 + 11 + 4 + 4 + 10) + (1 + 4 + 6 + 4 + 4 + 2) + (4 + 16));
+
+  std::vector<std::string> names_ = { "stale" };
+  std::vector<std::vector<std::uint16_t>> samples_{};
+  std::vector<std::array<std::int32_t, 2>> points_{};
+
+  bytepack::binary_stream reader(stream.data());
+  REQUIRE(reader.read(names_));
+  REQUIRE(reader.read<std::uint8_t>(samples_));
+  REQUIRE(reader.read(points_));
+  REQUIRE(names_ == names);
+  REQUIRE(samples_ == samples);
+  REQUIRE(points_ == points);
+}
+
+TEST_CASE("Nested containers - decode into a contiguous flat_vector (little-endian)")
+{
+  const std::vector<std::string> names = { "alpha", "", "gamma-delta" };
+  const std::vector<std::vector<std::int32_t>> samples = { { -1, 2 }, { 3 }, {}, { 4, 5, 6 } };
+
+  bytepack::binary_stream<std::endian::little> stream(256);
+  REQUIRE(stream.write(names, samples));
+
+  bytepack::flat_vector<char> names_{};
+  bytepack::flat_vector<std::int32_t> samples_{};
+
+  bytepack::binary_stream<std::endian::little> reader(stream.data());
+  REQUIRE(reader.read(names_));
+  REQUIRE(reader.read(samples_));
+
+  REQUIRE(names_.size() == 3);
+  REQUIRE(names_[0] == "alpha");
+  REQUIRE(names_[1].empty());
+  REQUIRE(names_[2] == "gamma-delta");
+  REQUIRE(names_.elements().size() == 16);
+
+  REQUIRE(samples_.size() == 4);
+  REQUIRE(samples_[0].size() == 2);
+  REQUIRE(samples_[0][0] == -1);
+  REQUIRE(samples_[3][2] == 6);
+  // Inner arrays are adjacent in a single buffer
+  REQUIRE(samples_[3].data() == samples_[1].data() + 1);
+
+  // flat_vector is serialized in the same format
+  stream.reset();
+  REQUIRE(stream.write(samples_));
+  std::vector<std::vector<std::int32_t>> samples_copy{};
+  REQUIRE(stream.read(samples_copy));
+  REQUIRE(samples_copy == samples);
+}
+
+TEST_CASE("Nested containers - flat_vector validation")
+{
+  bytepack::flat_vector<char> strings{};
+  strings.push_back("abc");
+  strings.push_back("de");
+  REQUIRE(strings.size() == 2);
+
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write<std::uint16_t, std::uint8_t>(strings));
+  REQUIRE(stream.data().size() == 2 + 1 + 3 + 1 + 2);
+
+  bytepack::flat_vector<char> strings_{};
+  REQUIRE(stream.read<std::uint16_t, std::uint8_t>(strings_));
+  REQUIRE(strings_[0] == "abc");
+  REQUIRE(strings_[1] == "de");
+
+  // Truncated data: inner length exceeds the buffer, read position is not changed
+  bytepack::binary_stream truncated(bytepack::buffer_view(stream.data().as<std::uint8_t>(), 7));
+  REQUIRE_FALSE(truncated.read<std::uint16_t, std::uint8_t>(strings_));
+  std::uint16_t count{};
+  REQUIRE(truncated.read(count));
+  REQUIRE(count == 2);
+}
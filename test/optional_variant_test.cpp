@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+TEST_CASE("Optional - presence byte serialization (big-endian)")
+{
+  const std::optional<std::uint32_t> opt1 = 0x01020304;
+  const std::optional<double> opt2 = std::nullopt;
+  const std::optional<std::string> opt3 = "optional string";
+  const std::optional<std::vector<std::int16_t>> opt4 = std::vector<std::int16_t>{ -1, 2, -3 };
+  const std::optional<std::array<char, 4>> opt5 = std::array<char, 4>{ 'a', 'b', 'c', 'd' };
+
+  bytepack::binary_stream stream(128);
+  REQUIRE(stream.write(opt1));
+  REQUIRE(stream.write(opt2, opt3, opt4, opt5));
+
+  const auto buffer = stream.data();
+  REQUIRE(buffer.as<std::uint8_t>()[0] == 1);
+  REQUIRE(buffer.as<std::uint8_t>()[1] == 0x01);
+  REQUIRE(buffer.as<std::uint8_t>()[5] == 0);
+  REQUIRE(buffer.size() == (1 + 4) + 1 + (1 + 4 + 15) + (1 + 4 + 6) + (1 + 4));
+
+  std::optional<std::uint32_t> opt1_{};
+  std::optional<double> opt2_ = 1.0;
+  std::optional<std::string> opt3_{};
+  std::optional<std::vector<std::int16_t>> opt4_{};
+  std::optional<std::array<char, 4>> opt5_{};
+
+  bytepack::binary_stream reader(buffer);
+  REQUIRE(reader.read(opt1_, opt2_, opt3_, opt4_, opt5_));
+  REQUIRE(opt1_ == opt1);
+  REQUIRE_FALSE(opt2_.has_value());
+  REQUIRE(opt3_ == opt3);
+  REQUIRE(opt4_ == opt4);
+  REQUIRE(opt5_ == opt5);
+
+  // Invalid presence byte
+  std::uint8_t invalid[2]{ 2, 0 };
+  bytepack::binary_stream invalid_reader(bytepack::buffer_view{ invalid });
+  std::optional<std::uint8_t> invalid_{};
+  REQUIRE_FALSE(invalid_reader.read(invalid_));
+
+  // Not enough space: nothing is written
+  bytepack::binary_stream small(4);
+  REQUIRE_FALSE(small.write(opt1));
+  REQUIRE(small.data().size() == 0);
+}
+
+TEST_CASE("Optional - presence bitmap serialization (little-endian)")
+{
+  const std::optional<std::uint16_t> a = 7;
+  const std::optional<std::uint16_t> b = std::nullopt;
+  const std::optional<float> c = 1.5f;
+
+  bytepack::binary_stream<std::endian::little> stream(32);
+  REQUIRE(stream.write_optionals(a, b, c));
+  REQUIRE(stream.data().size() == 1 + 2 + 4);
+  REQUIRE(stream.data().as<std::uint8_t>()[0] == 0b101);
+
+  std::optional<std::uint16_t> a_{};
+  std::optional<std::uint16_t> b_ = 3;
+  std::optional<float> c_{};
+  REQUIRE(stream.read_optionals(a_, b_, c_));
+  REQUIRE(a_ == a);
+  REQUIRE_FALSE(b_.has_value());
+  REQUIRE(c_ == c);
+
+  // Bits of non-existent optionals must be zero
+  std::uint8_t invalid[1]{ 0b1000 };
+  bytepack::binary_stream<std::endian::little> invalid_reader(bytepack::buffer_view{ invalid });
+  REQUIRE_FALSE(invalid_reader.read_optionals(a_, b_, c_));
+}
+
+TEST_CASE("Variant - tagged serialization (big-endian)")
+{
+  using Value = std::variant<std::monostate, std::int32_t, double, std::string, std::vector<std::uint8_t>>;
+
+  const Value v1 = std::int32_t{ -42 };
+  const Value v2 = std::string{ "variant" };
+  const Value v3 = std::vector<std::uint8_t>{ 1, 2, 3 };
+  const Value v4{};
+
+  bytepack::binary_stream stream(128);
+  REQUIRE(stream.write(v1, v2));
+  REQUIRE(stream.write<std::uint16_t>(v3));
+  REQUIRE(stream.write(v4));
+
+  const auto buffer = stream.data();
+  REQUIRE(buffer.as<std::uint8_t>()[0] == 1);
+  REQUIRE(buffer.size() == (1 + 4) + (1 + 4 + 7) + (2 + 4 + 3) + 1);
+
+  Value v1_{};
+  Value v2_ = std::string{ "previous value with capacity" };
+  Value v3_{};
+  Value v4_ = 1.0;
+
+  bytepack::binary_stream reader(buffer);
+  REQUIRE(reader.read(v1_, v2_));
+  REQUIRE(reader.read<std::uint16_t>(v3_));
+  REQUIRE(reader.read(v4_));
+  REQUIRE(v1_ == v1);
+  REQUIRE(v2_ == v2);
+  REQUIRE(v3_ == v3);
+  REQUIRE(std::holds_alternative<std::monostate>(v4_));
+
+  // Tag out of range
+  std::uint8_t invalid[1]{ 5 };
+  bytepack::binary_stream invalid_reader(bytepack::buffer_view{ invalid });
+  REQUIRE_FALSE(invalid_reader.read(v1_));
+}
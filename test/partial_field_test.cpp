@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+enum class Status : std::uint8_t { IDLE, ACTIVE, FAULT };
+
+// timestamp, identifier, serial number, voltages, status, alarm codes
+using SensorLayout = bytepack::field_layout<std::int64_t, std::uint32_t, char[12], std::array<float, 3>, Status,
+                                            std::uint16_t>;
+
+} // namespace
+
+TEST_CASE("Partial serialization - field layout offsets")
+{
+  static_assert(SensorLayout::field_count == 6);
+  static_assert(SensorLayout::size == 8 + 4 + 12 + 12 + 1 + 2);
+  static_assert(SensorLayout::offset<0> == 0);
+  static_assert(SensorLayout::offset<1> == 8);
+  static_assert(SensorLayout::offset<2> == 12);
+  static_assert(SensorLayout::offset<3> == 24);
+  static_assert(SensorLayout::offset<4> == 36);
+  static_assert(SensorLayout::offset<5> == 37);
+  static_assert(std::is_same_v<SensorLayout::field_type<3>, std::array<float, 3>>);
+  static_assert(bytepack::wire_size_v<std::array<std::uint16_t, 5>> == 10);
+}
+
+TEST_CASE("Partial deserialization - read single fields by index and byte offset (big-endian)")
+{
+  const std::int64_t timestamp = 1701037875;
+  const std::uint32_t identifier = 0xA1B2C3D4;
+  char serial_number[12] = "SN-00012345";
+  const std::array<float, 3> voltages = { 229.5f, 230.1f, 231.7f };
+  const Status status = Status::ACTIVE;
+  const std::uint16_t alarm_codes = 513;
+
+  bytepack::binary_stream stream(64);
+  REQUIRE(stream.write(timestamp, identifier, serial_number, voltages, status, alarm_codes));
+  REQUIRE(stream.data().size() == SensorLayout::size);
+
+  bytepack::binary_stream reader(stream.data());
+
+  std::uint32_t identifier_{};
+  std::int64_t timestamp_{};
+  std::uint16_t alarm_codes_{};
+  REQUIRE(reader.read_field<SensorLayout, 1>(identifier_));
+  REQUIRE(reader.read_field<SensorLayout, 0>(timestamp_));
+  REQUIRE(reader.read_field<37>(alarm_codes_));
+  REQUIRE(identifier_ == identifier);
+  REQUIRE(timestamp_ == timestamp);
+  REQUIRE(alarm_codes_ == alarm_codes);
+
+  char serial_number_[12]{};
+  std::array<float, 3> voltages_{};
+  Status status_{};
+  REQUIRE(reader.read_field<SensorLayout, 2>(serial_number_));
+  REQUIRE(reader.read_field<SensorLayout, 3>(voltages_));
+  REQUIRE(reader.read_field<SensorLayout, 4>(status_));
+  REQUIRE_THAT(serial_number_, Catch::Matchers::Equals(serial_number));
+  REQUIRE(voltages_ == voltages);
+  REQUIRE(status_ == status);
+
+  // Field reads do not move the read position
+  std::int64_t first{};
+  REQUIRE(reader.read(first));
+  REQUIRE(first == timestamp);
+
+  // Out of bounds field
+  std::uint32_t out_of_bounds{};
+  REQUIRE_FALSE(reader.read_field<SensorLayout::size - 2>(out_of_bounds));
+}
+
+TEST_CASE("Partial serialization - patch single fields in place (little-endian)")
+{
+  std::uint8_t raw[SensorLayout::size]{};
+  bytepack::buffer_view buffer(raw);
+  bytepack::binary_stream<std::endian::little> stream(buffer);
+
+  const std::uint32_t identifier = 42;
+  const std::array<float, 3> voltages = { 1.5f, 2.5f, 3.5f };
+  REQUIRE(stream.write_field<SensorLayout, 1>(identifier));
+  REQUIRE(stream.write_field<SensorLayout, 3>(voltages));
+  REQUIRE(stream.write_field<SensorLayout, 5>(std::uint16_t{ 0x0102 }));
+  REQUIRE(stream.data().size() == 0); // write position is untouched
+
+  REQUIRE(raw[8] == 42);
+  REQUIRE(raw[37] == 0x02);
+  REQUIRE(raw[38] == 0x01);
+
+  std::int64_t timestamp_{};
+  std::uint32_t identifier_{};
+  char serial_number_[12]{};
+  std::array<float, 3> voltages_{};
+  Status status_{};
+  std::uint16_t alarm_codes_{};
+  REQUIRE(stream.read(timestamp_, identifier_, serial_number_, voltages_, status_, alarm_codes_));
+  REQUIRE(identifier_ == identifier);
+  REQUIRE(voltages_ == voltages);
+  REQUIRE(alarm_codes_ == 0x0102);
+
+  REQUIRE_FALSE(stream.write_field<SensorLayout::size>(std::uint8_t{ 1 }));
+}
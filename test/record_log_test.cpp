@@ -0,0 +1,187 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/record_log.hpp>
+
+#include "test_records.hpp"
+
+#if !defined(_WIN32)
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using bytepack_test::test_record;
+
+// Timestamps increase by 10 and repeat in pairs: 0, 0, 10, 10, ...
+std::uint64_t timestamp_of(const std::uint64_t number) { return number / 2 * 10; }
+
+template<std::endian E = std::endian::big>
+void write_log(const std::filesystem::path& path, const std::uint64_t count,
+               const bytepack::record_log_options& options)
+{
+  bytepack::record_log_writer<E> writer(path.c_str(), options);
+  REQUIRE(writer.is_open());
+  std::size_t failures = 0;
+  for (std::uint64_t n = options.first_record; n < options.first_record + count; ++n) {
+    const test_record record = test_record::make(n);
+    if (!writer.append(timestamp_of(n), [&](auto& stream) { return record.serialize(stream); })) {
+      ++failures;
+    }
+  }
+  REQUIRE(failures == 0);
+  REQUIRE(writer.record_count() == count);
+  REQUIRE(writer.close());
+}
+
+// Reads records from the current position and returns the number of records that do not match test_record::make()
+template<std::endian E = std::endian::big>
+std::size_t read_mismatches(bytepack::record_log_reader<E>& reader, const std::size_t max_records)
+{
+  std::size_t mismatches = 0;
+  bytepack::log_record record{};
+  for (std::size_t i = 0; i < max_records && reader.next(record); ++i) {
+    bytepack::binary_reader<E> stream(record.data);
+    test_record decoded{};
+    if (!decoded.deserialize(stream) || decoded != test_record::make(record.number)
+        || record.timestamp != timestamp_of(record.number)) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+} // namespace
+
+TEST_CASE("Record log - random access by record number")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_record_log_test.bplog";
+  constexpr std::uint64_t record_count = 10000;
+  bytepack::record_log_options options;
+  options.index_interval = 16;
+  options.first_record = 5000; // second segment of a capture
+  write_log(path, record_count, options);
+
+  SECTION("whole file mapped")
+  {
+    bytepack::record_log_reader reader(path.c_str());
+    REQUIRE(reader.is_open());
+    REQUIRE(reader.first_record() == 5000);
+    REQUIRE(reader.record_count() == record_count);
+
+    // Sequential read without the index
+    REQUIRE(reader.position() == 5000);
+    REQUIRE(read_mismatches(reader, record_count) == 0);
+    REQUIRE(reader.position() == 5000 + record_count);
+
+    for (const std::uint64_t number : { 5000ULL, 5001ULL, 5015ULL, 5016ULL, 9999ULL, 14999ULL }) {
+      REQUIRE(reader.seek(number));
+      bytepack::log_record record{};
+      REQUIRE(reader.next(record));
+      REQUIRE(record.number == number);
+      bytepack::binary_reader stream(record.data);
+      test_record decoded{};
+      REQUIRE(decoded.deserialize(stream));
+      REQUIRE(decoded.number == number);
+    }
+    REQUIRE(reader.seek(14999));
+    REQUIRE(read_mismatches(reader, 10) == 0);
+    REQUIRE(reader.position() == 15000);
+
+    REQUIRE_FALSE(reader.seek(4999));
+    REQUIRE_FALSE(reader.seek(15000));
+    REQUIRE(reader.error() == 0);
+  }
+
+  SECTION("small mapping window")
+  {
+    bytepack::record_log_reader reader(path.c_str(), 4096);
+    REQUIRE(reader.seek(12345));
+    REQUIRE(reader.position() == 12345);
+    REQUIRE(read_mismatches(reader, 2000) == 0);
+    REQUIRE(reader.seek(6000));
+    REQUIRE(read_mismatches(reader, 100) == 0);
+    REQUIRE(reader.error() == 0);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Record log - time range")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_record_log_time_test.bplog";
+  write_log<std::endian::little>(path, 1000, bytepack::record_log_options{});
+
+  bytepack::record_log_reader<std::endian::little> reader(path.c_str());
+  REQUIRE(reader.seek_time(0));
+  REQUIRE(reader.position() == 0);
+  REQUIRE(reader.seek_time(1000)); // records 200 and 201
+  REQUIRE(reader.position() == 200);
+  REQUIRE(reader.seek_time(995));
+  REQUIRE(reader.position() == 200);
+  REQUIRE(reader.seek_time(4990));
+  REQUIRE(reader.position() == 998);
+  REQUIRE_FALSE(reader.seek_time(4991));
+  REQUIRE(reader.position() == 1000);
+
+  std::vector<std::uint64_t> numbers;
+  REQUIRE(reader.for_each_in_time_range(100, 130, [&](const bytepack::log_record& record) {
+    numbers.push_back(record.number);
+    return true;
+  }));
+  REQUIRE(numbers == std::vector<std::uint64_t>{ 20, 21, 22, 23, 24, 25 });
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Record log - pre-serialized records and invalid files")
+{
+  const auto path = std::filesystem::temp_directory_path() / "bytepack_record_log_invalid_test.bplog";
+  {
+    bytepack::record_log_writer writer(path.c_str());
+    std::uint8_t payload[]{ 1, 2, 3 };
+    REQUIRE(writer.append(7, bytepack::buffer_view(payload)));
+    REQUIRE(writer.append(8, bytepack::const_buffer_view(std::string_view(""))));
+  } // footer written by the destructor
+
+  {
+    bytepack::record_log_reader reader(path.c_str());
+    bytepack::log_record record{};
+    REQUIRE(reader.next(record));
+    REQUIRE(record.timestamp == 7);
+    REQUIRE(record.data.size() == 3);
+    REQUIRE(record.data.as<std::uint8_t>()[2] == 3);
+    REQUIRE(reader.next(record));
+    REQUIRE(record.data.is_empty());
+    REQUIRE_FALSE(reader.next(record));
+    REQUIRE(reader.error() == 0);
+  }
+
+  // Segment without footer (e.g. the writer was not closed)
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  bytepack::record_log_reader truncated(path.c_str());
+  REQUIRE_FALSE(truncated.is_open());
+  REQUIRE(truncated.error() == EINVAL);
+
+  // Footer with records but an empty index: header (16 bytes) + trailer (24 bytes)
+  {
+    bytepack::binary_stream stream(40);
+    REQUIRE(stream.write(bytepack::detail::record_log_magic, bytepack::detail::record_log_version, std::uint16_t{ 0 },
+                         std::uint64_t{ 0 }));
+    REQUIRE(stream.write(std::uint64_t{ 5 }, std::uint64_t{ 16 }, std::uint32_t{ 64 },
+                         bytepack::detail::record_index_magic));
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(stream.data().as<char>(), static_cast<std::streamsize>(stream.data().size()));
+  }
+  bytepack::record_log_reader no_index(path.c_str());
+  REQUIRE_FALSE(no_index.is_open());
+  REQUIRE(no_index.error() == EINVAL);
+  REQUIRE_FALSE(no_index.seek(0));
+
+  bytepack::record_log_reader missing("/nonexistent_bytepack_directory/file.bplog");
+  REQUIRE_FALSE(missing.is_open());
+
+  std::filesystem::remove(path);
+}
+
+#endif
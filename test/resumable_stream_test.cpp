@@ -0,0 +1,224 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/resumable_stream.hpp>
+
+namespace {
+
+struct Header
+{
+  std::uint16_t type{};
+  std::int64_t timestamp{};
+
+  bool operator==(const Header&) const = default;
+};
+
+struct Message
+{
+  Header header;
+  std::string name;
+  std::vector<double> values;
+  std::array<std::int32_t, 3> position{};
+  char code[4]{};
+  std::string fixed;
+
+  template<std::endian E>
+  bool serialize(bytepack::binary_stream<E>& stream) const noexcept
+  {
+    return stream.write(header.type, header.timestamp, name, values, position, code)
+           && stream.template write<8>(fixed);
+  }
+
+  bool operator==(const Message& other) const
+  {
+    return header == other.header && name == other.name && values == other.values && position == other.position
+           && std::string_view(code, 4) == std::string_view(other.code, 4) && fixed == other.fixed;
+  }
+};
+
+template<std::endian E>
+bytepack::decode_task decode_header(bytepack::resumable_stream<E>& stream, Header& header)
+{
+  co_await stream.read(header.type);
+  co_await stream.read(header.timestamp);
+}
+
+template<std::endian E>
+bytepack::decode_task decode(bytepack::resumable_stream<E>& stream, Message& msg, bool& ok)
+{
+  co_await decode_header(stream, msg.header);
+  ok = co_await stream.read(msg.name) && co_await stream.read(msg.values) && co_await stream.read(msg.position)
+       && co_await stream.read(msg.code) && co_await stream.template read<8>(msg.fixed);
+}
+
+const Message message{
+  { 7, -1'700'000'000'000 }, "resumable", { 1.5, -2.25, 3.0 }, { 1, -2, 3 }, { 'A', 'B', 'C', 'D' }, "fix"
+};
+
+template<std::endian E>
+std::vector<std::uint8_t> serialize(const Message& msg)
+{
+  bytepack::binary_stream<E> stream(256);
+  REQUIRE(msg.serialize(stream));
+  const auto data = stream.data();
+  return std::vector<std::uint8_t>(data.template as<std::uint8_t>(), data.template as<std::uint8_t>() + data.size());
+}
+
+} // namespace
+
+TEST_CASE("Resumable stream - whole message in one chunk")
+{
+  auto bytes = serialize<std::endian::big>(message);
+
+  bytepack::resumable_stream stream;
+  Message decoded{};
+  bool ok = false;
+  auto task = decode(stream, decoded, ok);
+  REQUIRE_FALSE(task.done());
+  REQUIRE(stream.waiting());
+
+  REQUIRE(stream.feed(bytepack::buffer_view(bytes.data(), bytes.size())) == bytes.size());
+  REQUIRE(task.done());
+  REQUIRE(ok);
+  REQUIRE(decoded == message);
+  REQUIRE_FALSE(stream.waiting());
+  REQUIRE(stream.offset() == bytes.size());
+}
+
+TEST_CASE("Resumable stream - message split at every position")
+{
+  auto bytes = serialize<std::endian::little>(message);
+
+  // Two chunks, split at every byte
+  std::size_t failures = 0;
+  for (std::size_t split = 0; split <= bytes.size(); ++split) {
+    bytepack::resumable_stream<std::endian::little> stream;
+    Message decoded{};
+    bool ok = false;
+    auto task = decode(stream, decoded, ok);
+    stream.feed(bytepack::buffer_view(bytes.data(), split));
+    stream.feed(bytepack::buffer_view(bytes.data() + split, bytes.size() - split));
+    if (!task.done() || !ok || !(decoded == message)) {
+      ++failures;
+    }
+  }
+  REQUIRE(failures == 0);
+
+  // One byte at a time
+  bytepack::resumable_stream<std::endian::little> stream;
+  Message decoded{};
+  bool ok = false;
+  auto task = decode(stream, decoded, ok);
+  std::size_t chunks = 0;
+  for (std::uint8_t& byte : bytes) {
+    REQUIRE_FALSE(task.done());
+    REQUIRE(stream.feed(bytepack::buffer_view(&byte, 1)) == 1);
+    ++chunks;
+  }
+  REQUIRE(task.done());
+  REQUIRE(ok);
+  REQUIRE(decoded == message);
+  REQUIRE(chunks == bytes.size());
+}
+
+TEST_CASE("Resumable stream - consecutive messages")
+{
+  std::vector<std::uint8_t> bytes;
+  for (int i = 0; i < 3; ++i) {
+    Message msg = message;
+    msg.header.type = static_cast<std::uint16_t>(i);
+    const auto serialized = serialize<std::endian::big>(msg);
+    bytes.insert(bytes.end(), serialized.begin(), serialized.end());
+  }
+
+  bytepack::resumable_stream stream;
+  std::vector<Message> received;
+  Message decoded{};
+  bool ok = false;
+  auto task = decode(stream, decoded, ok);
+
+  // Chunks of 10 bytes; the rest of a chunk is fed to the next decoder
+  for (std::size_t offset = 0; offset < bytes.size(); offset += 10) {
+    bytepack::buffer_view chunk(bytes.data() + offset, std::min<std::size_t>(10, bytes.size() - offset));
+    while (chunk.size() > 0) {
+      const std::size_t consumed = stream.feed(chunk);
+      chunk = bytepack::buffer_view(chunk.as<std::uint8_t>() + consumed, chunk.size() - consumed);
+      if (task.done()) {
+        REQUIRE(ok);
+        received.push_back(decoded);
+        task = decode(stream, decoded, ok);
+      }
+    }
+  }
+  REQUIRE(received.size() == 3);
+  REQUIRE(received[2].header.type == 2);
+  REQUIRE(received[1].values == message.values);
+}
+
+TEST_CASE("Resumable stream - failures")
+{
+  SECTION("length prefix above the limit")
+  {
+    bytepack::binary_stream stream(16);
+    REQUIRE(stream.write(std::uint32_t{ 1000 }));
+
+    bytepack::resumable_stream input(100);
+    std::string name;
+    bool ok = true;
+    auto task = [](bytepack::resumable_stream<>& s, std::string& value, bool& result) -> bytepack::decode_task {
+      result = co_await s.read(value);
+    }(input, name, ok);
+
+    input.feed(stream.data());
+    REQUIRE(task.done());
+    REQUIRE_FALSE(ok);
+    REQUIRE(input.error().code == bytepack::error_code::invalid_size);
+    REQUIRE(input.error().offset == 0);
+    REQUIRE(name.empty());
+  }
+
+  SECTION("end of input")
+  {
+    std::uint8_t bytes[]{ 0x00, 0x01, 0x02 };
+    bytepack::resumable_stream input;
+    std::uint8_t first{};
+    std::uint32_t value{};
+    bool ok = true;
+    auto task = [](bytepack::resumable_stream<>& s, std::uint8_t& f, std::uint32_t& v,
+                   bool& result) -> bytepack::decode_task { result = co_await s.read(f) && co_await s.read(v); }(
+      input, first, value, ok);
+
+    input.feed(bytepack::buffer_view(bytes));
+    REQUIRE_FALSE(task.done());
+    input.close();
+    REQUIRE(task.done());
+    REQUIRE_FALSE(ok);
+    REQUIRE(input.error().code == bytepack::error_code::buffer_overflow);
+    REQUIRE(input.error().offset == 1); // start of the truncated field
+  }
+}
+
+TEST_CASE("Resumable stream - decoder destroyed while waiting")
+{
+  const auto bytes = serialize<std::endian::big>(message);
+
+  bytepack::resumable_stream stream;
+  Message decoded{};
+  bool ok = false;
+  {
+    // Suspended in the nested header decoder
+    auto task = decode(stream, decoded, ok);
+    REQUIRE(stream.feed(bytepack::const_buffer_view(bytes.data(), 4)) == 4);
+    REQUIRE(stream.waiting());
+  }
+  REQUIRE_FALSE(stream.waiting());
+
+  // Nothing to resume: the bytes are left for the next decoder
+  REQUIRE(stream.feed(bytepack::const_buffer_view(bytes.data() + 4, 4)) == 0);
+  REQUIRE(stream.error().code == bytepack::error_code::success);
+
+  auto task = decode(stream, decoded, ok);
+  REQUIRE(stream.feed(bytepack::const_buffer_view(bytes.data(), bytes.size())) == bytes.size());
+  REQUIRE(task.done());
+  REQUIRE(ok);
+  REQUIRE(decoded == message);
+}
@@ -0,0 +1,38 @@
+#ifndef BYTEPACK_TEST_RECORDS_HPP
+#define BYTEPACK_TEST_RECORDS_HPP
+
+#include <bytepack/bytepack.hpp>
+
+namespace bytepack_test {
+
+// Variable-length record shared by the batching, file and log tests. Record `number` is built by `make(number)`, so
+// readers can check every record they decode against it.
+struct test_record
+{
+  std::uint64_t number{};
+  std::string payload;
+
+  template<typename Stream>
+  bool serialize(Stream& stream) const noexcept
+  {
+    return stream.write(number, payload);
+  }
+
+  template<typename Stream>
+  bool deserialize(Stream& stream) noexcept
+  {
+    return stream.read(number, payload);
+  }
+
+  bool operator==(const test_record&) const = default;
+
+  // 12 bytes (number and payload size) plus a payload of 0 to 49 bytes
+  static test_record make(const std::uint64_t number)
+  {
+    return test_record{ number, std::string(number % 50, static_cast<char>('a' + number % 26)) };
+  }
+};
+
+} // namespace bytepack_test
+
+#endif // BYTEPACK_TEST_RECORDS_HPP
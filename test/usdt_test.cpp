@@ -0,0 +1,26 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/usdt.hpp>
+
+TEST_CASE("USDT probes - stream behavior is unchanged")
+{
+  // Probes are compiled in only when <sys/sdt.h> is available
+  static_assert(bytepack::usdt_probes::enabled == bytepack::detail::usdt_available);
+
+  bytepack::binary_stream<std::endian::big, bytepack::usdt_probes> stream(16);
+  const std::array<std::uint16_t, 3> values = { 1, 2, 3 };
+  REQUIRE(stream.write(values, std::string("abc")));
+  REQUIRE_FALSE(stream.write(std::uint64_t{ 4 }));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.error().offset == 13);
+
+  bytepack::binary_stream<std::endian::big, bytepack::usdt_probes> reader(stream.data());
+  std::array<std::uint16_t, 3> values_{};
+  std::string str;
+  REQUIRE(reader.read(values_, str));
+  REQUIRE(values_ == values);
+  REQUIRE(str == "abc");
+
+  stream.reset();
+  REQUIRE_FALSE(stream.error());
+}
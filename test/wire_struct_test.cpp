@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+
+#include <bytepack/bytepack.hpp>
+
+namespace {
+
+struct SensorSample
+{
+  std::uint32_t id;
+  std::int16_t value;
+  std::uint8_t flags[2];
+
+  using wire_layout = bytepack::field_layout<std::uint32_t, std::int16_t, std::uint8_t[2]>;
+};
+
+// Single-byte fields only: qualifies for streams of any endianness
+struct StatusByte
+{
+  std::uint8_t code;
+  char tag[3];
+
+  using wire_layout = bytepack::field_layout<std::uint8_t, char[3]>;
+};
+
+using native_stream = bytepack::binary_stream<std::endian::native>;
+
+std::vector<std::uint8_t> bytes_of(const bytepack::buffer_view& data)
+{
+  return { data.as<std::uint8_t>(), data.as<std::uint8_t>() + data.size() };
+}
+
+} // namespace
+
+static_assert(bytepack::WireStruct<SensorSample>);
+static_assert(bytepack::WireStruct<std::uint32_t> == false);
+static_assert(bytepack::detail::check_wire_struct<StatusByte, std::endian::big>());
+
+// Layouts whose fields leave alignment holes, e.g. a wire_layout that does not match `{ uint8_t; uint32_t; }`
+static_assert(bytepack::detail::is_hole_free(bytepack::field_layout<std::uint32_t, std::int16_t, std::uint8_t[2]>{}));
+static_assert(bytepack::detail::is_hole_free(bytepack::field_layout<std::uint8_t, std::uint32_t>{}) == false);
+static_assert(bytepack::detail::is_hole_free(bytepack::field_layout<std::uint32_t, std::uint8_t>{}) == false);
+
+TEST_CASE("Wire struct - same bytes as field-by-field serialization")
+{
+  const SensorSample sample{ 0x01020304, -300, { 0xAA, 0x55 } };
+
+  native_stream fields(64);
+  REQUIRE(fields.write(sample.id, sample.value, sample.flags));
+
+  native_stream wire(64);
+  REQUIRE(wire.write(sample));
+  REQUIRE(bytes_of(wire.data()) == bytes_of(fields.data()));
+
+  SensorSample decoded{};
+  REQUIRE(wire.read(decoded));
+  REQUIRE(decoded.id == sample.id);
+  REQUIRE(decoded.value == sample.value);
+  REQUIRE(decoded.flags[0] == 0xAA);
+  REQUIRE(decoded.flags[1] == 0x55);
+  REQUIRE(wire.read_offset() == sizeof(SensorSample));
+
+  // Single-byte fields on a big-endian stream
+  const StatusByte status{ 7, { 'O', 'K', '!' } };
+  bytepack::binary_stream big(8);
+  REQUIRE(big.write(status));
+  REQUIRE(bytes_of(big.data()) == std::vector<std::uint8_t>{ 7, 'O', 'K', '!' });
+  StatusByte status_decoded{};
+  REQUIRE(big.read(status_decoded));
+  REQUIRE(status_decoded.code == 7);
+  REQUIRE(std::string_view(status_decoded.tag, 3) == "OK!");
+}
+
+TEST_CASE("Wire struct - vectors")
+{
+  std::vector<SensorSample> samples(1000);
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = SensorSample{ static_cast<std::uint32_t>(i), static_cast<std::int16_t>(i * 3), { 1, 2 } };
+  }
+
+  native_stream fields(16384);
+  bool fields_ok = fields.write(static_cast<std::uint16_t>(samples.size()));
+  for (const auto& sample : samples) {
+    fields_ok = fields_ok && fields.write(sample.id, sample.value, sample.flags);
+  }
+  REQUIRE(fields_ok);
+
+  native_stream wire(16384);
+  REQUIRE(wire.write<std::uint16_t>(samples));
+  REQUIRE(wire.data().size() == 2 + samples.size() * sizeof(SensorSample));
+  REQUIRE(bytes_of(wire.data()) == bytes_of(fields.data()));
+
+  std::vector<SensorSample> decoded;
+  REQUIRE(wire.read<std::uint16_t>(decoded));
+  REQUIRE(decoded.size() == samples.size());
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    if (decoded[i].id != samples[i].id || decoded[i].value != samples[i].value || decoded[i].flags[1] != 2) {
+      ++mismatches;
+    }
+  }
+  REQUIRE(mismatches == 0);
+
+  // Mixed with other fields in a single call
+  native_stream mixed(256);
+  const std::vector<StatusByte> statuses{ { 1, { 'a', 'b', 'c' } }, { 2, { 'd', 'e', 'f' } } };
+  REQUIRE(mixed.write(std::uint8_t{ 9 }, samples[5], statuses));
+  std::uint8_t head{};
+  SensorSample sample{};
+  std::vector<StatusByte> statuses_decoded;
+  REQUIRE(mixed.read(head, sample, statuses_decoded));
+  REQUIRE(head == 9);
+  REQUIRE(sample.id == 5);
+  REQUIRE(statuses_decoded.size() == 2);
+  REQUIRE(statuses_decoded[1].tag[2] == 'f');
+}
+
+TEST_CASE("Wire struct - errors")
+{
+  native_stream stream(10);
+  const std::vector<SensorSample> samples(2);
+  REQUIRE_FALSE(stream.write(samples));
+  REQUIRE(stream.error().code == bytepack::error_code::buffer_overflow);
+  REQUIRE(stream.data().size() == 0);
+
+  const std::uint8_t bytes[]{ 0x00, 0x00, 0x00, 0x02, 0x01 };
+  bytepack::binary_reader<std::endian::big> reader(bytepack::const_buffer_view{ bytes });
+  std::vector<StatusByte> statuses;
+  REQUIRE_FALSE(reader.read(statuses));
+  REQUIRE(reader.error().code == bytepack::error_code::buffer_overflow);
+}
@@ -0,0 +1,947 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023-2024 Faruk Eryilmaz
+ *
+ * Contact: faruk [at] farukeryilmaz [dot] com
+ * GitHub: https://github.com/farukeryilmaz/bytepack
+ *
+ * Licensed under the MIT License. See accompanying LICENSE file
+ * or copy at https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file schemac.cpp
+ * @brief BytePack schema compiler. Reads a message definition file and generates a header with one struct per message
+ * (straight-line `binary_stream` based `serialize`/`deserialize` functions, precomputed sizes and field offsets) and,
+ * optionally, a Catch2 round-trip test for each message.
+ *
+ * Usage: bytepack_schemac <schema.bpidl> <output.hpp> [--tests <output_test.cpp>]
+ *
+ * Schema format (`#` or `//` starts a comment):
+ *
+ *   namespace grid::telemetry;      // optional, namespace of the generated code
+ *   endian big;                     // optional, default endianness of messages (big or little)
+ *
+ *   enum Status : uint8 { IDLE, ACTIVE, FAULT = 5 }
+ *
+ *   message TransformerData {       // or e.g. `message TransformerData little {`
+ *     int64 timestamp;
+ *     uint32 identifier;
+ *     char[20] serial_number;       // fixed-size array
+ *     float32[3] voltage;
+ *     Status status;
+ *     string<uint8> name;           // variable-length string, length prefix type (default uint32)
+ *     vector<float32, uint16> load; // variable-length vector, element count prefix type (default uint32)
+ *   }
+ *
+ * Scalar types: bool, char, int8, int16, int32, int64, uint8, uint16, uint32, uint64, float32, float64.
+ */
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct scalar_info
+{
+  std::string_view cpp_type;
+  std::size_t size;
+  bool is_integer;
+};
+
+const std::map<std::string, scalar_info, std::less<>> scalar_types = {
+  { "bool", { "bool", 1, false } },
+  { "char", { "char", 1, false } },
+  { "int8", { "std::int8_t", 1, true } },
+  { "int16", { "std::int16_t", 2, true } },
+  { "int32", { "std::int32_t", 4, true } },
+  { "int64", { "std::int64_t", 8, true } },
+  { "uint8", { "std::uint8_t", 1, true } },
+  { "uint16", { "std::uint16_t", 2, true } },
+  { "uint32", { "std::uint32_t", 4, true } },
+  { "uint64", { "std::uint64_t", 8, true } },
+  { "float32", { "float", 4, false } },
+  { "float64", { "double", 8, false } },
+};
+
+// C++ keywords (and alternative tokens) cannot be used as names in the generated code
+const std::set<std::string, std::less<>> cpp_keywords = {
+  "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+  "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+  "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double",
+  "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if",
+  "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+  "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed",
+  "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw",
+  "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+  "wchar_t", "while", "xor", "xor_eq",
+};
+
+// Members of the generated message structs
+const std::set<std::string, std::less<>> generated_members = {
+  "endian", "stream_type", "layout", "fixed_wire_size", "offsets", "wire_size", "serialize", "deserialize",
+};
+
+struct enum_def
+{
+  std::string name;
+  std::string underlying; // schema scalar type name
+  std::vector<std::pair<std::string, std::int64_t>> enumerators;
+};
+
+enum class field_kind { scalar, array, string, vector };
+
+struct field_def
+{
+  std::string name;
+  field_kind kind{ field_kind::scalar };
+  std::string element;                 // schema scalar or enum name (unused for strings)
+  std::size_t count{ 0 };              // element count of arrays
+  std::string size_type{ "uint32" };   // length prefix type of strings and vectors
+  std::size_t line{ 0 };
+};
+
+struct message_def
+{
+  std::string name;
+  std::string endian;
+  std::vector<field_def> fields;
+};
+
+struct schema
+{
+  std::string ns;
+  std::string endian{ "big" };
+  std::vector<enum_def> enums;
+  std::vector<message_def> messages;
+};
+
+struct token
+{
+  enum class kind { identifier, number, symbol, end };
+
+  kind type{ kind::end };
+  std::string text;
+  std::size_t line{ 0 };
+};
+
+std::vector<token> tokenize(const std::string& source)
+{
+  std::vector<token> tokens;
+  std::size_t line = 1;
+  for (std::size_t i = 0; i < source.size();) {
+    const char c = source[i];
+    if (c == '\n') {
+      ++line;
+      ++i;
+    } else if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+      ++i;
+    } else if (c == '#' || (c == '/' && i + 1 < source.size() && source[i + 1] == '/')) {
+      while (i < source.size() && source[i] != '\n') {
+        ++i;
+      }
+    } else if (std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_') {
+      const std::size_t begin = i;
+      while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) != 0 || source[i] == '_')) {
+        ++i;
+      }
+      tokens.push_back({ token::kind::identifier, source.substr(begin, i - begin), line });
+    } else if (std::isdigit(static_cast<unsigned char>(c)) != 0
+               || (c == '-' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])) != 0)) {
+      const std::size_t begin = i++;
+      while (i < source.size() && std::isdigit(static_cast<unsigned char>(source[i])) != 0) {
+        ++i;
+      }
+      tokens.push_back({ token::kind::number, source.substr(begin, i - begin), line });
+    } else if (c == ':' && i + 1 < source.size() && source[i + 1] == ':') {
+      tokens.push_back({ token::kind::symbol, "::", line });
+      i += 2;
+    } else {
+      tokens.push_back({ token::kind::symbol, std::string(1, c), line });
+      ++i;
+    }
+  }
+  tokens.push_back({ token::kind::end, "end of file", line });
+  return tokens;
+}
+
+/**
+ * Recursive descent parser of the schema format. Parse functions return false after reporting the first error.
+ */
+class parser
+{
+public:
+  explicit parser(std::vector<token> tokens) : tokens_{ std::move(tokens) } {}
+
+  std::optional<schema> parse()
+  {
+    schema result;
+    while (peek().type != token::kind::end) {
+      const token& keyword = peek();
+      bool parsed = false;
+      if (keyword.text == "namespace") {
+        parsed = parse_namespace(result);
+      } else if (keyword.text == "endian") {
+        advance();
+        parsed = parse_endian(result.endian) && expect(";");
+      } else if (keyword.text == "enum") {
+        parsed = parse_enum(result);
+      } else if (keyword.text == "message") {
+        parsed = parse_message(result);
+      } else {
+        parsed = error(keyword, "expected 'namespace', 'endian', 'enum' or 'message'");
+      }
+      if (parsed == false) {
+        return std::nullopt;
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] const std::string& error_message() const noexcept { return error_; }
+
+private:
+  const token& peek() const noexcept { return tokens_[position_]; }
+
+  const token& advance() noexcept
+  {
+    const token& current = tokens_[position_];
+    if (current.type != token::kind::end) {
+      ++position_;
+    }
+    return current;
+  }
+
+  bool error(const token& at, const std::string& message)
+  {
+    error_ = "line " + std::to_string(at.line) + ": " + message + " (found '" + at.text + "')";
+    return false;
+  }
+
+  bool expect(const std::string_view symbol)
+  {
+    if (peek().text != symbol) {
+      return error(peek(), "expected '" + std::string(symbol) + "'");
+    }
+    advance();
+    return true;
+  }
+
+  bool identifier(std::string& name)
+  {
+    if (peek().type != token::kind::identifier) {
+      return error(peek(), "expected identifier");
+    }
+    name = advance().text;
+    return true;
+  }
+
+  // Identifier that is used as a name in the generated code
+  bool name_identifier(std::string& name)
+  {
+    const token& at = peek();
+    if (identifier(name) == false) {
+      return false;
+    }
+    if (cpp_keywords.contains(name)) {
+      return error(at, "name is a C++ keyword");
+    }
+    return true;
+  }
+
+  bool number(std::int64_t& value)
+  {
+    if (peek().type != token::kind::number) {
+      return error(peek(), "expected number");
+    }
+    const token& at = advance();
+    const char* end = at.text.data() + at.text.size();
+    const auto [ptr, ec] = std::from_chars(at.text.data(), end, value);
+    if (ec == std::errc::result_out_of_range) {
+      return error(at, "number is out of range");
+    }
+    if (ec != std::errc{} || ptr != end) {
+      return error(at, "invalid number");
+    }
+    return true;
+  }
+
+  bool is_type_name(const schema& result, const std::string& name) const
+  {
+    if (scalar_types.contains(name) || name == "string" || name == "vector") {
+      return true;
+    }
+    for (const auto& e : result.enums) {
+      if (e.name == name) {
+        return true;
+      }
+    }
+    for (const auto& m : result.messages) {
+      if (m.name == name) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool parse_namespace(schema& result)
+  {
+    advance();
+    std::string part;
+    if (name_identifier(part) == false) {
+      return false;
+    }
+    result.ns = part;
+    while (peek().text == "::") {
+      advance();
+      if (name_identifier(part) == false) {
+        return false;
+      }
+      result.ns += "::" + part;
+    }
+    return expect(";");
+  }
+
+  bool parse_endian(std::string& endian)
+  {
+    if (peek().text != "big" && peek().text != "little") {
+      return error(peek(), "expected 'big' or 'little'");
+    }
+    endian = advance().text;
+    return true;
+  }
+
+  bool parse_integer_type(std::string& name)
+  {
+    const token& at = peek();
+    if (identifier(name) == false) {
+      return false;
+    }
+    const auto it = scalar_types.find(name);
+    if (it == scalar_types.end() || it->second.is_integer == false) {
+      return error(at, "expected integer type");
+    }
+    return true;
+  }
+
+  bool parse_enum(schema& result)
+  {
+    advance();
+    enum_def e;
+    const token& name_token = peek();
+    if (name_identifier(e.name) == false) {
+      return false;
+    }
+    if (is_type_name(result, e.name)) {
+      return error(name_token, "type is already defined");
+    }
+    if (expect(":") == false || parse_integer_type(e.underlying) == false || expect("{") == false) {
+      return false;
+    }
+
+    // Range of the underlying type (uint64 values are limited to the range of int64)
+    const std::size_t size = scalar_types.at(e.underlying).size;
+    const bool is_signed = e.underlying.starts_with("int");
+    const std::int64_t min_value = is_signed == false ? 0
+                                   : size == 8        ? std::numeric_limits<std::int64_t>::min()
+                                                      : -(std::int64_t{ 1 } << (8 * size - 1));
+    const std::int64_t max_value = size == 8 ? std::numeric_limits<std::int64_t>::max()
+                                             : (std::int64_t{ 1 } << (8 * size - (is_signed ? 1 : 0))) - 1;
+
+    std::set<std::string, std::less<>> names;
+    std::int64_t next_value = 0;
+    bool next_in_range = true; // false if the previous value was the maximum of int64
+    while (peek().text != "}") {
+      std::string enumerator;
+      const token& enumerator_token = peek();
+      if (name_identifier(enumerator) == false) {
+        return false;
+      }
+      if (names.insert(enumerator).second == false) {
+        return error(enumerator_token, "duplicate enumerator");
+      }
+      const token& value_token = peek().text == "=" ? tokens_[position_ + 1] : enumerator_token;
+      if (peek().text == "=") {
+        advance();
+        if (number(next_value) == false) {
+          return false;
+        }
+        next_in_range = true;
+      }
+      if (next_in_range == false || next_value < min_value || next_value > max_value) {
+        return error(value_token, "enumerator value is out of range of " + e.underlying);
+      }
+      e.enumerators.emplace_back(enumerator, next_value);
+      next_in_range = next_value < std::numeric_limits<std::int64_t>::max();
+      next_value += next_in_range ? 1 : 0;
+      if (peek().text != ",") {
+        break;
+      }
+      advance();
+    }
+    if (e.enumerators.empty()) {
+      return error(peek(), "enum has no enumerators");
+    }
+    if (expect("}") == false) {
+      return false;
+    }
+    result.enums.push_back(std::move(e));
+    return true;
+  }
+
+  bool parse_message(schema& result)
+  {
+    advance();
+    message_def m;
+    const token& name_token = peek();
+    if (name_identifier(m.name) == false) {
+      return false;
+    }
+    if (is_type_name(result, m.name)) {
+      return error(name_token, "type is already defined");
+    }
+    m.endian = result.endian;
+    if (peek().text != "{" && parse_endian(m.endian) == false) {
+      return false;
+    }
+    if (expect("{") == false) {
+      return false;
+    }
+
+    std::set<std::string, std::less<>> names;
+    while (peek().text != "}") {
+      field_def f;
+      if (parse_field(result, f) == false) {
+        return false;
+      }
+      if (generated_members.contains(f.name) || f.name == m.name || is_type_name(result, f.name)) {
+        error_ = "line " + std::to_string(f.line) + ": field name '" + f.name
+                 + "' clashes with a generated member or a type name";
+        return false;
+      }
+      if (names.insert(f.name).second == false) {
+        error_ = "line " + std::to_string(f.line) + ": duplicate field '" + f.name + "'";
+        return false;
+      }
+      m.fields.push_back(std::move(f));
+    }
+    if (m.fields.empty()) {
+      return error(peek(), "message has no fields");
+    }
+    advance();
+    result.messages.push_back(std::move(m));
+    return true;
+  }
+
+  bool parse_field(const schema& result, field_def& f)
+  {
+    const token& type_token = peek();
+    f.line = type_token.line;
+    std::string type_name;
+    if (identifier(type_name) == false) {
+      return false;
+    }
+
+    if (type_name == "string" || type_name == "vector") {
+      f.kind = type_name == "string" ? field_kind::string : field_kind::vector;
+      const bool has_arguments = peek().text == "<";
+      if (f.kind == field_kind::vector && has_arguments == false) {
+        return error(peek(), "expected '<'");
+      }
+      if (has_arguments) {
+        advance();
+        if (f.kind == field_kind::vector) {
+          const token& element_token = peek();
+          if (parse_element(result, f.element) == false) {
+            return false;
+          }
+          if (f.element == "bool") {
+            return error(element_token, "vector<bool> is not supported, use vector<uint8>");
+          }
+          if (peek().text == ",") {
+            advance();
+            if (parse_integer_type(f.size_type) == false) {
+              return false;
+            }
+          }
+        } else if (parse_integer_type(f.size_type) == false) {
+          return false;
+        }
+        if (expect(">") == false) {
+          return false;
+        }
+      }
+    } else {
+      f.element = type_name;
+      if (is_element(result, type_name) == false) {
+        return error(type_token, "unknown type");
+      }
+      if (peek().text == "[") {
+        advance();
+        std::int64_t count = 0;
+        const token& count_token = peek();
+        if (number(count) == false) {
+          return false;
+        }
+        if (count <= 0) {
+          return error(count_token, "array size must be positive");
+        }
+        f.kind = field_kind::array;
+        f.count = static_cast<std::size_t>(count);
+        if (expect("]") == false) {
+          return false;
+        }
+      }
+    }
+
+    return name_identifier(f.name) && expect(";");
+  }
+
+  bool parse_element(const schema& result, std::string& element)
+  {
+    const token& at = peek();
+    if (identifier(element) == false) {
+      return false;
+    }
+    if (is_element(result, element) == false) {
+      return error(at, "unknown element type");
+    }
+    return true;
+  }
+
+  static bool is_element(const schema& result, const std::string& name)
+  {
+    if (scalar_types.contains(name)) {
+      return true;
+    }
+    for (const auto& e : result.enums) {
+      if (e.name == name) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<token> tokens_;
+  std::size_t position_{ 0 };
+  std::string error_;
+};
+
+/**
+ * Generates C++ code for a parsed schema.
+ */
+class generator
+{
+public:
+  explicit generator(const schema& s) : schema_{ s } {}
+
+  std::string header(const std::string& guard, const std::string& source_name) const
+  {
+    std::ostringstream out;
+    out << "// Generated by bytepack_schemac from " << source_name << ". Do not edit.\n\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    out << "#include <array>\n#include <cstddef>\n#include <cstdint>\n#include <string>\n#include <vector>\n\n";
+    out << "#include <bytepack/bytepack.hpp>\n\n";
+    open_namespace(out);
+
+    for (const auto& e : schema_.enums) {
+      out << "enum class " << e.name << " : " << scalar_types.at(e.underlying).cpp_type << " {";
+      for (std::size_t i = 0; i < e.enumerators.size(); ++i) {
+        const std::int64_t value = e.enumerators[i].second;
+        out << (i == 0 ? " " : ", ") << e.enumerators[i].first << " = ";
+        if (value == std::numeric_limits<std::int64_t>::min()) {
+          out << "-9223372036854775807 - 1"; // the literal 9223372036854775808 does not fit in int64
+        } else {
+          out << value;
+        }
+      }
+      out << " };\n\n";
+    }
+
+    for (const auto& m : schema_.messages) {
+      message(out, m);
+    }
+
+    close_namespace(out);
+    out << "#endif // " << guard << "\n";
+    return out.str();
+  }
+
+  std::string tests(const std::string& header_name) const
+  {
+    std::ostringstream out;
+    out << "// Generated by bytepack_schemac. Do not edit.\n\n";
+    out << "#include <catch2/catch.hpp>\n\n#include \"" << header_name << "\"\n\n";
+    if (schema_.ns.empty() == false) {
+      out << "using namespace " << schema_.ns << ";\n\n";
+    }
+
+    for (const auto& m : schema_.messages) {
+      out << "TEST_CASE(\"Generated " << m.name << " - round trip\")\n{\n";
+      out << "  " << m.name << " message{};\n";
+      for (std::size_t i = 0; i < m.fields.size(); ++i) {
+        sample(out, m.fields[i], i + 1);
+      }
+      out << "\n  " << m.name << "::stream_type stream(message.wire_size());\n";
+      out << "  REQUIRE(message.serialize(stream));\n";
+      out << "  REQUIRE(stream.data().size() == message.wire_size());\n\n";
+      out << "  " << m.name << " decoded{};\n";
+      out << "  " << m.name << "::stream_type reader(stream.data());\n";
+      out << "  REQUIRE(decoded.deserialize(reader));\n";
+      out << "  REQUIRE(decoded == message);\n";
+
+      if (fixed_prefix_count(m) == m.fields.size()) {
+        out << "\n  // Single fields at their precomputed offsets\n";
+        for (std::size_t i = 0; i < m.fields.size(); ++i) {
+          out << "  {\n    " << field_type(m.fields[i]) << " value{};\n";
+          out << "    REQUIRE(reader.read_field<" << m.name << "::offsets::" << m.fields[i].name
+              << ">(value));\n";
+          out << "    REQUIRE(value == message." << m.fields[i].name << ");\n  }\n";
+        }
+      }
+
+      out << "\n  // Truncated data is rejected\n";
+      out << "  " << m.name << "::stream_type truncated(\n";
+      out << "    bytepack::buffer_view(stream.data().as<std::uint8_t>(), message.wire_size() - 1));\n";
+      out << "  " << m.name << " truncated_decoded{};\n";
+      out << "  REQUIRE_FALSE(truncated_decoded.deserialize(truncated));\n";
+      out << "}\n\n";
+    }
+    return out.str();
+  }
+
+private:
+  void open_namespace(std::ostringstream& out) const
+  {
+    if (schema_.ns.empty() == false) {
+      out << "namespace " << schema_.ns << " {\n\n";
+    }
+  }
+
+  void close_namespace(std::ostringstream& out) const
+  {
+    if (schema_.ns.empty() == false) {
+      out << "} // namespace " << schema_.ns << "\n\n";
+    }
+  }
+
+  const enum_def* find_enum(const std::string& name) const
+  {
+    for (const auto& e : schema_.enums) {
+      if (e.name == name) {
+        return &e;
+      }
+    }
+    return nullptr;
+  }
+
+  std::string element_type(const std::string& element) const
+  {
+    const auto it = scalar_types.find(element);
+    return it != scalar_types.end() ? std::string(it->second.cpp_type) : element;
+  }
+
+  std::size_t element_size(const std::string& element) const
+  {
+    const enum_def* e = find_enum(element);
+    return scalar_types.at(e != nullptr ? e->underlying : element).size;
+  }
+
+  std::string field_type(const field_def& f) const
+  {
+    switch (f.kind) {
+      case field_kind::array:
+        return "std::array<" + element_type(f.element) + ", " + std::to_string(f.count) + ">";
+      case field_kind::string:
+        return "std::string";
+      case field_kind::vector:
+        return "std::vector<" + element_type(f.element) + ">";
+      case field_kind::scalar:
+        break;
+    }
+    return element_type(f.element);
+  }
+
+  static bool is_fixed(const field_def& f) noexcept
+  {
+    return f.kind == field_kind::scalar || f.kind == field_kind::array;
+  }
+
+  // Number of leading fixed-size fields (their offsets are known at compile time)
+  static std::size_t fixed_prefix_count(const message_def& m) noexcept
+  {
+    std::size_t count = 0;
+    while (count < m.fields.size() && is_fixed(m.fields[count])) {
+      ++count;
+    }
+    return count;
+  }
+
+  std::size_t fixed_size(const field_def& f) const
+  {
+    switch (f.kind) {
+      case field_kind::scalar:
+        return element_size(f.element);
+      case field_kind::array:
+        return element_size(f.element) * f.count;
+      case field_kind::string:
+      case field_kind::vector:
+        break;
+    }
+    return scalar_types.at(f.size_type).size; // length prefix
+  }
+
+  // Fields with the default length prefix are serialized in a single variadic call
+  static bool is_variadic(const field_def& f) noexcept { return is_fixed(f) || f.size_type == "uint32"; }
+
+  // Renders `stream.<method>(names...)` starting at the given column, wrapping the arguments at the column limit
+  static std::string variadic_call(const std::string_view method, const std::vector<std::string>& names,
+                                   const std::size_t column)
+  {
+    std::string result = "stream." + std::string(method) + "(";
+    const std::size_t indent = column + result.size();
+    std::size_t line_length = indent;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      const std::size_t length = names[i].size() + (i + 1 == names.size() ? 1 : 2);
+      if (i != 0 && line_length + 1 + length > 120) {
+        result += "\n" + std::string(indent, ' ');
+        line_length = indent;
+      } else if (i != 0) {
+        result += " ";
+        ++line_length;
+      }
+      result += names[i] + (i + 1 == names.size() ? ")" : ",");
+      line_length += length;
+    }
+    return result;
+  }
+
+  // Straight-line body of serialize/deserialize: fields with the default length prefix are grouped in variadic calls
+  std::string call(const message_def& m, const std::string_view method) const
+  {
+    constexpr std::size_t first_column = 11;   // "    return "
+    constexpr std::size_t next_column = 14;    // "           && "
+
+    std::vector<std::string> calls;
+    std::vector<std::string> group;
+    const auto flush = [&] {
+      if (group.empty() == false) {
+        calls.push_back(variadic_call(method, group, calls.empty() ? first_column : next_column));
+        group.clear();
+      }
+    };
+    for (const auto& f : m.fields) {
+      if (is_variadic(f)) {
+        group.push_back(f.name);
+        continue;
+      }
+      flush();
+      calls.push_back("stream." + std::string(method) + "<" + std::string(scalar_types.at(f.size_type).cpp_type) + ">("
+                      + f.name + ")");
+    }
+    flush();
+
+    std::string result;
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+      result += (i == 0 ? "" : "\n           && ") + calls[i];
+    }
+    return result;
+  }
+
+  void message(std::ostringstream& out, const message_def& m) const
+  {
+    const std::size_t prefix_count = fixed_prefix_count(m);
+    const bool all_fixed = prefix_count == m.fields.size();
+
+    std::size_t total_fixed = 0;
+    for (const auto& f : m.fields) {
+      total_fixed += fixed_size(f);
+    }
+
+    out << "struct " << m.name << "\n{\n";
+    out << "  static constexpr std::endian endian = std::endian::" << m.endian << ";\n";
+    out << "  using stream_type = bytepack::binary_stream<endian>;\n";
+    if (all_fixed) {
+      std::string layout = "  using layout = bytepack::field_layout<";
+      const std::size_t indent = layout.size();
+      std::size_t line_begin = 0;
+      for (std::size_t i = 0; i < m.fields.size(); ++i) {
+        const std::string type = field_type(m.fields[i]) + (i + 1 == m.fields.size() ? ">;" : ",");
+        if (i != 0 && layout.size() - line_begin + 1 + type.size() > 120) {
+          line_begin = layout.size() + 1;
+          layout += "\n" + std::string(indent, ' ');
+        } else if (i != 0) {
+          layout += " ";
+        }
+        layout += type;
+      }
+      out << layout << "\n";
+    }
+    out << "\n  // Serialized size of the fixed-size fields and length prefixes in bytes\n";
+    out << "  static constexpr std::size_t fixed_wire_size = " << total_fixed << ";\n\n";
+
+    out << "  // Byte offsets of the leading fixed-size fields\n";
+    out << "  struct offsets\n  {\n";
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < prefix_count; ++i) {
+      out << "    static constexpr std::size_t " << m.fields[i].name << " = " << offset << ";\n";
+      offset += fixed_size(m.fields[i]);
+    }
+    out << "  };\n\n";
+
+    for (const auto& f : m.fields) {
+      out << "  " << field_type(f) << " " << f.name << "{};\n";
+    }
+
+    out << "\n  [[nodiscard]] " << (all_fixed ? "constexpr " : "") << "std::size_t wire_size() const noexcept\n  {\n";
+    out << "    return fixed_wire_size";
+    for (const auto& f : m.fields) {
+      if (f.kind == field_kind::string) {
+        out << " + " << f.name << ".size()";
+      } else if (f.kind == field_kind::vector) {
+        out << " + " << f.name << ".size() * " << element_size(f.element);
+      }
+    }
+    out << ";\n  }\n\n";
+
+    out << "  bool serialize(stream_type& stream) const noexcept\n  {\n";
+    out << "    return " << call(m, "write") << ";\n  }\n\n";
+    out << "  bool deserialize(stream_type& stream) noexcept\n  {\n";
+    out << "    return " << call(m, "read") << ";\n  }\n\n";
+    out << "  bool operator==(const " << m.name << "&) const = default;\n";
+    out << "};\n\n";
+  }
+
+  // Emits statements assigning a deterministic non-default value to the field
+  void sample(std::ostringstream& out, const field_def& f, const std::size_t seed) const
+  {
+    const std::string name = "message." + f.name;
+    if (f.kind == field_kind::string) {
+      out << "  " << name << " = \"" << f.name << "\";\n";
+      return;
+    }
+    if (f.kind == field_kind::scalar) {
+      out << "  " << name << " = " << scalar_sample(f.element, seed) << ";\n";
+      return;
+    }
+    if (f.kind == field_kind::vector) {
+      out << "  " << name << ".resize(3);\n";
+    }
+    out << "  for (std::size_t i = 0; i < " << name << ".size(); ++i) {\n";
+    out << "    " << name << "[i] = " << element_sample(f.element, seed) << ";\n  }\n";
+  }
+
+  std::string scalar_sample(const std::string& element, const std::size_t seed) const
+  {
+    if (const enum_def* e = find_enum(element); e != nullptr) {
+      return e->name + "::" + e->enumerators.back().first;
+    }
+    if (element == "bool") {
+      return "true";
+    }
+    if (element == "char") {
+      return "'" + std::string(1, static_cast<char>('a' + seed % 26)) + "'";
+    }
+    if (element == "float32") {
+      return std::to_string(seed) + ".5f";
+    }
+    if (element == "float64") {
+      return std::to_string(seed) + ".25";
+    }
+    return std::to_string(seed % 100);
+  }
+
+  std::string element_sample(const std::string& element, const std::size_t seed) const
+  {
+    if (const enum_def* e = find_enum(element); e != nullptr) {
+      return e->name + "::" + e->enumerators.back().first;
+    }
+    if (element == "bool") {
+      return "i % 2 == 0";
+    }
+    if (element == "char") {
+      return "static_cast<char>('a' + i % 26)";
+    }
+    const std::string type = element_type(element);
+    if (element == "float32" || element == "float64") {
+      return "static_cast<" + type + ">(i) + " + scalar_sample(element, seed);
+    }
+    return "static_cast<" + type + ">((i + " + std::to_string(seed) + ") % 100)";
+  }
+
+  const schema& schema_;
+};
+
+std::string base_name(const std::string& path)
+{
+  const std::size_t slash = path.find_last_of("/\\");
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::string include_guard(const std::string& path)
+{
+  std::string guard = "BYTEPACK_GENERATED_";
+  for (const char c : base_name(path)) {
+    guard += std::isalnum(static_cast<unsigned char>(c)) != 0 ? static_cast<char>(std::toupper(c)) : '_';
+  }
+  return guard;
+}
+
+bool write_file(const std::string& path, const std::string& content)
+{
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+  if (file.good() == false) {
+    std::cerr << "bytepack_schemac: cannot write " << path << "\n";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  if ((args.size() != 2 && args.size() != 4) || (args.size() == 4 && args[2] != "--tests")) {
+    std::cerr << "usage: bytepack_schemac <schema.bpidl> <output.hpp> [--tests <output_test.cpp>]\n";
+    return 2;
+  }
+
+  std::ifstream input(args[0], std::ios::binary);
+  if (input.good() == false) {
+    std::cerr << "bytepack_schemac: cannot read " << args[0] << "\n";
+    return 1;
+  }
+  std::ostringstream source;
+  source << input.rdbuf();
+
+  parser p(tokenize(source.str()));
+  const std::optional<schema> parsed = p.parse();
+  if (parsed.has_value() == false) {
+    std::cerr << args[0] << ": " << p.error_message() << "\n";
+    return 1;
+  }
+
+  const generator g(*parsed);
+  if (write_file(args[1], g.header(include_guard(args[1]), base_name(args[0]))) == false) {
+    return 1;
+  }
+  if (args.size() == 4 && write_file(args[3], g.tests(base_name(args[1]))) == false) {
+    return 1;
+  }
+  return 0;
+}